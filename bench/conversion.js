@@ -0,0 +1,176 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Runs the conversion micro-benchmarks of the bench addon (build it with
+// `npm run build:bench`) and prints a JSON report. No database is needed.
+//
+//   node bench/conversion.js [--addon path] [--out report.json]
+//     [--baseline report.json] [--threshold percent] [--min-time ms]
+//     [--filter substring]
+//
+// With --baseline, every benchmark which is slower than the baseline by more
+// than the threshold (10% by default) is reported and the exit code is 1.
+
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+
+function parseArgs(argv) {
+  const args = {
+    addon: path.join(__dirname, '..', 'build', 'Release',
+      'nodemgclient_bench.node'),
+    out: null,
+    baseline: null,
+    threshold: 10,
+    minTime: 500,
+    filter: '',
+  };
+  for (let index = 0; index < argv.length; index += 2) {
+    const name = argv[index].replace(/^--/, '').replace(/-(\w)/g,
+      (_, letter) => letter.toUpperCase());
+    if (!(name in args) || index + 1 >= argv.length) {
+      throw new Error(`Unknown or incomplete argument ${argv[index]}.`);
+    }
+    const value = argv[index + 1];
+    args[name] = typeof args[name] === 'number' ? Number(value) : value;
+  }
+  return args;
+}
+
+// JS inputs mirroring the native shapes.
+function encodeInputs() {
+  const range = (size) => [...Array(size).keys()];
+  const wideMap = {};
+  for (const index of range(1000)) {
+    wideMap[`key${index}`] = BigInt(index);
+  }
+  let deepList = null;
+  for (const depth of range(64)) {
+    deepList = [BigInt(depth), deepList];
+  }
+  return {
+    scalars: range(10000).map((index) =>
+      [BigInt(index), index * 0.5, index % 3 !== 0, null][index % 4]),
+    wide_map: wideMap,
+    deep_list: deepList,
+    long_string: 'x'.repeat(1024 * 1024),
+    rows: range(1000).map((index) => ({ id: BigInt(index),
+      name: `name${index}` })),
+    float64_array: Float64Array.from(range(100000), (index) => index * 0.5),
+    temporals: range(1000).map((index) => [
+      { objectType: 'date', days: BigInt(index) },
+      { objectType: 'local_time', nanoseconds: BigInt(index) },
+      { objectType: 'local_date_time', seconds: BigInt(index),
+        nanoseconds: BigInt(index) },
+      { objectType: 'duration', days: BigInt(index), seconds: BigInt(index),
+        nanoseconds: BigInt(index) },
+    ][index % 4]),
+  };
+}
+
+// Doubles the iteration count until a single run takes at least minTime.
+function measure(name, minTime, run) {
+  run(1);
+  let iterations = 1;
+  for (;;) {
+    const result = run(iterations);
+    const seconds = result.nanoseconds / 1e9;
+    if (result.nanoseconds >= minTime * 1e6 || iterations >= 2 ** 30) {
+      const report = {
+        name: name,
+        iterations: iterations,
+        nanoseconds: result.nanoseconds,
+        opsPerSecond: iterations / seconds,
+        bytesPerSecond: (result.bytes * iterations) / seconds,
+      };
+      if (result.buildNanoseconds !== undefined) {
+        report.buildOpsPerSecond = iterations / (result.buildNanoseconds / 1e9);
+      }
+      return report;
+    }
+    iterations *= 2;
+  }
+}
+
+function compare(results, baseline, threshold) {
+  const previous = new Map(baseline.results.map((result) =>
+    [result.name, result]));
+  const regressions = [];
+  for (const result of results) {
+    const before = previous.get(result.name);
+    if (!before) {
+      continue;
+    }
+    const change = (result.opsPerSecond / before.opsPerSecond - 1) * 100;
+    if (change < -threshold) {
+      regressions.push({ name: result.name, change: change });
+    }
+  }
+  return regressions;
+}
+
+function main() {
+  const args = parseArgs(process.argv.slice(2));
+  const bench = require(path.resolve(args.addon));
+  const benchmarks = [];
+  for (const shape of bench.Shapes()) {
+    benchmarks.push([`decode/${shape}`,
+      (iterations) => bench.DecodeShape(shape, iterations)]);
+  }
+  for (const shape of ['nodes', 'relationships', 'path']) {
+    benchmarks.push([`decode/${shape}/lazy`, (iterations) =>
+      bench.DecodeShape(shape, iterations, { lazyGraph: true })]);
+  }
+  benchmarks.push(['decode/scalars/numbers', (iterations) =>
+    bench.DecodeShape('scalars', iterations, { integers: 'number' })]);
+  for (const [shape, value] of Object.entries(encodeInputs())) {
+    benchmarks.push([`encode/value/${shape}`,
+      (iterations) => bench.EncodeValue(value, iterations)]);
+    benchmarks.push([`encode/map/${shape}`,
+      (iterations) => bench.EncodeMap({ value: value }, iterations)]);
+    benchmarks.push([`encode/params/${shape}`,
+      (iterations) => bench.EncodeParams({ value: value }, iterations)]);
+  }
+
+  const results = benchmarks
+    .filter(([name]) => name.includes(args.filter))
+    .map(([name, run]) => measure(name, args.minTime, run));
+  const report = {
+    node: process.version,
+    platform: `${os.platform()}-${os.arch()}`,
+    cpu: os.cpus()[0].model,
+    timestamp: new Date().toISOString(),
+    results: results,
+  };
+  const output = JSON.stringify(report, null, 2);
+  if (args.out) {
+    fs.writeFileSync(args.out, output + '\n');
+  } else {
+    console.log(output);
+  }
+
+  if (args.baseline) {
+    const baseline = JSON.parse(fs.readFileSync(args.baseline, 'utf8'));
+    const regressions = compare(results, baseline, args.threshold);
+    for (const regression of regressions) {
+      console.error(`${regression.name}: ${regression.change.toFixed(1)}% ` +
+        'ops/s compared to the baseline');
+    }
+    if (regressions.length > 0) {
+      process.exitCode = 1;
+    }
+  }
+}
+
+main();
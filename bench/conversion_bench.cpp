@@ -0,0 +1,322 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Micro-benchmark addon of the conversion layer (src/glue.cpp and
+// src/params.cpp). The mg_value trees are synthetic, so no database is
+// needed. bench/conversion.js drives the functions and writes the report.
+
+#include <mgclient.h>
+#include <napi.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "client.hpp"
+#include "glue.hpp"
+#include "graph.hpp"
+#include "params.hpp"
+#include "util.hpp"
+
+namespace nodemg::bench {
+
+template <typename T>
+static T *Checked(T *value) {
+  if (!value) {
+    throw std::bad_alloc();
+  }
+  return value;
+}
+
+static mg_string *MakeString(const std::string &value) {
+  return Checked(
+      mg_string_make2(static_cast<uint32_t>(value.size()), value.data()));
+}
+
+static mg_map *MakeProperties(int64_t id) {
+  auto *properties = Checked(mg_map_make_empty(2));
+  mg_map_insert_unsafe2(properties, MakeString("id"),
+                        Checked(mg_value_make_integer(id)));
+  mg_map_insert_unsafe2(
+      properties, MakeString("name"),
+      Checked(mg_value_make_string2(MakeString("name" + std::to_string(id)))));
+  return properties;
+}
+
+static mg_node *MakeNode(int64_t id) {
+  mg_string *labels[] = {MakeString("Person"), MakeString("Employee")};
+  return Checked(mg_node_make(id, 2, labels, MakeProperties(id)));
+}
+
+static MgValuePtr MakeList(uint32_t size,
+                           const std::function<mg_value *(uint32_t)> &make) {
+  auto *list = Checked(mg_list_make_empty(size));
+  for (uint32_t index = 0; index < size; ++index) {
+    mg_list_append(list, Checked(make(index)));
+  }
+  return MgValuePtr(Checked(mg_value_make_list(list)));
+}
+
+// The shapes cover the distinct code paths of MgValueToNapiValue.
+static MgValuePtr MakeShape(const std::string &name) {
+  if (name == "scalars") {
+    return MakeList(10000, [](uint32_t index) {
+      switch (index % 4) {
+        case 0:
+          return mg_value_make_integer(index);
+        case 1:
+          return mg_value_make_float(index * 0.5);
+        case 2:
+          return mg_value_make_bool(static_cast<int>(index % 3));
+        default:
+          return mg_value_make_null();
+      }
+    });
+  }
+  if (name == "wide_map") {
+    auto *map = Checked(mg_map_make_empty(1000));
+    for (int64_t index = 0; index < 1000; ++index) {
+      mg_map_insert_unsafe2(map, MakeString("key" + std::to_string(index)),
+                            Checked(mg_value_make_integer(index)));
+    }
+    return MgValuePtr(Checked(mg_value_make_map(map)));
+  }
+  if (name == "deep_list") {
+    MgValuePtr value(Checked(mg_value_make_null()));
+    for (int64_t depth = 0; depth < 64; ++depth) {
+      auto *list = Checked(mg_list_make_empty(2));
+      mg_list_append(list, Checked(mg_value_make_integer(depth)));
+      mg_list_append(list, value.release());
+      value.reset(Checked(mg_value_make_list(list)));
+    }
+    return value;
+  }
+  if (name == "long_string") {
+    return MgValuePtr(Checked(mg_value_make_string2(
+        MakeString(std::string(1024 * 1024, 'x')))));
+  }
+  if (name == "nodes") {
+    return MakeList(1000, [](uint32_t index) {
+      return mg_value_make_node(MakeNode(index));
+    });
+  }
+  if (name == "relationships") {
+    return MakeList(1000, [](uint32_t index) {
+      return mg_value_make_relationship(
+          Checked(mg_relationship_make(index, index, index + 1,
+                                       MakeString("KNOWS"),
+                                       MakeProperties(index))));
+    });
+  }
+  if (name == "path") {
+    constexpr uint32_t kLength = 100;
+    std::vector<mg_node *> nodes;
+    std::vector<mg_unbound_relationship *> relationships;
+    std::vector<int64_t> sequence;
+    for (uint32_t index = 0; index <= kLength; ++index) {
+      nodes.push_back(MakeNode(index));
+    }
+    for (uint32_t index = 0; index < kLength; ++index) {
+      relationships.push_back(Checked(mg_unbound_relationship_make(
+          index, MakeString("NEXT"), MakeProperties(index))));
+      sequence.push_back(index + 1);
+      sequence.push_back(index + 1);
+    }
+    return MgValuePtr(Checked(mg_value_make_path(Checked(mg_path_make(
+        kLength + 1, nodes.data(), kLength, relationships.data(),
+        static_cast<uint32_t>(sequence.size()), sequence.data())))));
+  }
+  if (name == "temporals") {
+    return MakeList(1000, [](uint32_t index) {
+      switch (index % 4) {
+        case 0:
+          return mg_value_make_date(Checked(mg_date_make(index)));
+        case 1:
+          return mg_value_make_local_time(Checked(mg_local_time_make(index)));
+        case 2:
+          return mg_value_make_local_date_time(
+              Checked(mg_local_date_time_make(index, index)));
+        default:
+          return mg_value_make_duration(
+              Checked(mg_duration_make(0, index, index, index)));
+      }
+    });
+  }
+  return nullptr;
+}
+
+static const char *const kShapes[] = {
+    "scalars", "wide_map",      "deep_list", "long_string",
+    "nodes",   "relationships", "path",      "temporals",
+};
+
+using Clock = std::chrono::steady_clock;
+
+static int64_t ElapsedNanoseconds(Clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                              start)
+      .count();
+}
+
+static Napi::Object MakeResult(Napi::Env env, int64_t nanoseconds,
+                               uint64_t bytes) {
+  auto result = Napi::Object::New(env);
+  result.Set("nanoseconds", Napi::Number::New(env, nanoseconds));
+  result.Set("bytes", Napi::Number::New(env, static_cast<double>(bytes)));
+  return result;
+}
+
+static std::optional<uint32_t> GetIterations(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  if (info.Length() < 2 || !info[1].IsNumber()) {
+    NODEMG_THROW("The iteration count has to be a number.");
+    return std::nullopt;
+  }
+  return info[1].As<Napi::Number>().Uint32Value();
+}
+
+Napi::Value Shapes(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  auto shapes = Napi::Array::New(env);
+  for (const auto *shape : kShapes) {
+    shapes.Set(shapes.Length(), Napi::String::New(env, shape));
+  }
+  return shapes;
+}
+
+// DecodeShape(shape, iterations, options) times MgValueToNapiValue.
+Napi::Value DecodeShape(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  auto iterations = GetIterations(info);
+  if (!iterations) {
+    return env.Undefined();
+  }
+  auto value = MakeShape(info[0].As<Napi::String>().Utf8Value());
+  if (!value) {
+    NODEMG_THROW("Unknown benchmark shape.");
+    return env.Undefined();
+  }
+  auto options = NapiObjectToDecodeOptions(
+      env, info.Length() > 2 ? info[2] : env.Undefined(), DecodeOptions());
+  if (!options) {
+    return env.Undefined();
+  }
+  auto start = Clock::now();
+  for (uint32_t iteration = 0; iteration < *iterations; ++iteration) {
+    Napi::HandleScope scope(env);
+    DecodeContext ctx(env, *options);
+    if (!MgValueToNapiValue(ctx, value.get())) {
+      NODEMG_THROW("Failed to convert the benchmark value.");
+      return env.Undefined();
+    }
+  }
+  return MakeResult(env, ElapsedNanoseconds(start),
+                    MgValuePayloadBytes(value.get()));
+}
+
+// EncodeValue(value, iterations) times NapiValueToMgValue.
+Napi::Value EncodeValue(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  auto iterations = GetIterations(info);
+  if (!iterations) {
+    return env.Undefined();
+  }
+  uint64_t bytes = 0;
+  auto start = Clock::now();
+  for (uint32_t iteration = 0; iteration < *iterations; ++iteration) {
+    auto value = NapiValueToMgValue(env, info[0]);
+    if (!value) {
+      return env.Undefined();
+    }
+    MgValuePtr owned(*value);
+    if (iteration == 0) {
+      bytes = MgValuePayloadBytes(owned.get());
+    }
+  }
+  return MakeResult(env, ElapsedNanoseconds(start), bytes);
+}
+
+// EncodeMap(object, iterations) times NapiObjectToMgMap.
+Napi::Value EncodeMap(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  auto iterations = GetIterations(info);
+  if (!iterations) {
+    return env.Undefined();
+  }
+  uint64_t bytes = 0;
+  auto start = Clock::now();
+  for (uint32_t iteration = 0; iteration < *iterations; ++iteration) {
+    auto map = NapiObjectToMgMap(env, info[0].As<Napi::Object>());
+    if (!map) {
+      return env.Undefined();
+    }
+    MgMapPtr owned(*map);
+    if (iteration == 0) {
+      bytes = MgMapPayloadBytes(owned.get());
+    }
+  }
+  return MakeResult(env, ElapsedNanoseconds(start), bytes);
+}
+
+// EncodeParams(object, iterations) times the main thread snapshot of the
+// query parameters, and separately the map built from it on the worker.
+Napi::Value EncodeParams(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  auto iterations = GetIterations(info);
+  if (!iterations) {
+    return env.Undefined();
+  }
+  auto arenas = std::make_shared<ArenaPool>();
+  uint64_t bytes = 0;
+  int64_t build_nanoseconds = 0;
+  auto start = Clock::now();
+  for (uint32_t iteration = 0; iteration < *iterations; ++iteration) {
+    auto snapshot =
+        NapiObjectToParamSnapshot(env, info[0].As<Napi::Object>(), arenas);
+    if (!snapshot) {
+      return env.Undefined();
+    }
+    auto build_start = Clock::now();
+    auto map = snapshot->Build();
+    build_nanoseconds += ElapsedNanoseconds(build_start);
+    if (iteration == 0) {
+      bytes = MgMapPayloadBytes(map.get());
+    }
+  }
+  auto result = MakeResult(env, ElapsedNanoseconds(start) - build_nanoseconds,
+                           bytes);
+  result.Set("buildNanoseconds", Napi::Number::New(env, build_nanoseconds));
+  return result;
+}
+
+}  // namespace nodemg::bench
+
+Napi::Object InitBench(Napi::Env env, Napi::Object exports) {
+  namespace bench = nodemg::bench;
+  // The lazyGraph option creates the native graph objects.
+  nodemg::Node::Init(env, exports);
+  nodemg::Relationship::Init(env, exports);
+  nodemg::Path::Init(env, exports);
+  exports.Set("Shapes", Napi::Function::New(env, bench::Shapes));
+  exports.Set("DecodeShape", Napi::Function::New(env, bench::DecodeShape));
+  exports.Set("EncodeValue", Napi::Function::New(env, bench::EncodeValue));
+  exports.Set("EncodeMap", Napi::Function::New(env, bench::EncodeMap));
+  exports.Set("EncodeParams", Napi::Function::New(env, bench::EncodeParams));
+  return exports;
+}
+
+NODE_API_MODULE(bench, InitBench)
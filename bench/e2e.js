@@ -0,0 +1,189 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// End-to-end client benchmark against the Bolt stand-in server
+// (test/fixture/bolt_server.js), which runs in a worker_thread so that it
+// doesn't share the event loop with the client. No database is needed.
+//
+//   node bench/e2e.js [--duration ms] [--rows count] [--shape name]
+//     [--latency ms] [--concurrency 1,4,16] [--out report.json]
+//
+// Every scenario runs `concurrency` connections in parallel for `duration`
+// and reports queries/s, rows/s and the p50/p99 latency of one operation.
+
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const {
+  Worker,
+  isMainThread,
+  parentPort,
+  workerData,
+} = require('worker_threads');
+
+const BENCH_QUERY = 'MATCH (n) RETURN n;';
+
+function runServer() {
+  const { BoltServer } = require('../test/fixture/bolt_server');
+  const server = new BoltServer({
+    results: { [BENCH_QUERY]: { shape: workerData.shape,
+      rows: workerData.rows } },
+    latency: workerData.latency,
+  });
+  server.listen().then((port) => parentPort.postMessage(port));
+  parentPort.on('message', () => server.close().then(() =>
+    parentPort.close()));
+}
+
+function parseArgs(argv) {
+  const args = {
+    duration: 2000,
+    rows: 100,
+    shape: 'wide',
+    latency: 0,
+    concurrency: '1,4,16',
+    out: null,
+  };
+  for (let index = 0; index < argv.length; index += 2) {
+    const name = argv[index].replace(/^--/, '');
+    if (!(name in args) || index + 1 >= argv.length) {
+      throw new Error(`Unknown or incomplete argument ${argv[index]}.`);
+    }
+    const value = argv[index + 1];
+    args[name] = typeof args[name] === 'number' ? Number(value) : value;
+  }
+  args.concurrency = args.concurrency.split(',').map(Number);
+  return args;
+}
+
+function percentile(sorted, fraction) {
+  if (sorted.length === 0) {
+    return 0;
+  }
+  return sorted[Math.min(sorted.length - 1,
+    Math.floor(sorted.length * fraction))];
+}
+
+// Each operation returns the number of received rows and counts as
+// `queries` queries.
+const SCENARIOS = {
+  ExecuteAndFetchAll: {
+    queries: 1,
+    run: async (connection) =>
+      (await connection.ExecuteAndFetchAll(BENCH_QUERY)).length,
+  },
+  FetchOne: {
+    queries: 1,
+    run: async (connection) => {
+      await connection.Execute(BENCH_QUERY);
+      let rows = 0;
+      while ((await connection.client.FetchOne()) !== null) {
+        ++rows;
+      }
+      return rows;
+    },
+  },
+  Transaction: {
+    queries: 3,
+    run: async (connection) => {
+      await connection.Begin();
+      let rows = 0;
+      for (let index = 0; index < 3; ++index) {
+        rows += (await connection.ExecuteAndFetchAll(BENCH_QUERY)).length;
+      }
+      await connection.Commit();
+      return rows;
+    },
+  },
+};
+
+async function runScenario(memgraph, port, name, concurrency, duration) {
+  const scenario = SCENARIOS[name];
+  const connections = await Promise.all([...Array(concurrency)].map(() =>
+    memgraph.Connect({ host: '127.0.0.1', port: port })));
+  // Warm up every connection.
+  await Promise.all(connections.map((connection) => scenario.run(connection)));
+  const latencies = [];
+  let operations = 0;
+  let rows = 0;
+  const start = process.hrtime.bigint();
+  const end = start + BigInt(duration) * 1000000n;
+  await Promise.all(connections.map(async (connection) => {
+    while (process.hrtime.bigint() < end) {
+      const operationStart = process.hrtime.bigint();
+      rows += await scenario.run(connection);
+      latencies.push(Number(process.hrtime.bigint() - operationStart) / 1e6);
+      ++operations;
+    }
+  }));
+  const seconds = Number(process.hrtime.bigint() - start) / 1e9;
+  latencies.sort((a, b) => a - b);
+  return {
+    name: `${name}/c${concurrency}`,
+    operations: operations,
+    queriesPerSecond: (operations * scenario.queries) / seconds,
+    rowsPerSecond: rows / seconds,
+    p50Milliseconds: percentile(latencies, 0.5),
+    p99Milliseconds: percentile(latencies, 0.99),
+  };
+}
+
+async function main() {
+  const args = parseArgs(process.argv.slice(2));
+  const memgraph = require(path.join(__dirname, '..'));
+  const server = new Worker(__filename, { workerData: args });
+  const port = await new Promise((resolve, reject) => {
+    server.once('message', resolve);
+    server.once('error', reject);
+  });
+  const results = [];
+  try {
+    for (const name of Object.keys(SCENARIOS)) {
+      for (const concurrency of args.concurrency) {
+        results.push(await runScenario(memgraph, port, name, concurrency,
+          args.duration));
+      }
+    }
+  } finally {
+    server.postMessage('close');
+  }
+  const report = {
+    node: process.version,
+    platform: `${os.platform()}-${os.arch()}`,
+    cpu: os.cpus()[0].model,
+    timestamp: new Date().toISOString(),
+    options: {
+      rows: args.rows,
+      shape: args.shape,
+      latency: args.latency,
+      duration: args.duration,
+    },
+    results: results,
+  };
+  const output = JSON.stringify(report, null, 2);
+  if (args.out) {
+    fs.writeFileSync(args.out, output + '\n');
+  } else {
+    console.log(output);
+  }
+}
+
+if (isMainThread) {
+  main().catch((error) => {
+    console.error(error);
+    process.exitCode = 1;
+  });
+} else {
+  runServer();
+}
@@ -12,8 +12,6 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-// TODO(gitbuda): Port EventEmitter code to async.
-
 const memgraph = require('..');
 const query = require('../test/queries');
 const EventEmitter = require('events').EventEmitter;
@@ -23,27 +21,31 @@ const emitter = new EventEmitter()
     console.log('### START ###');
   })
   .on('record', (record) => {
-    console.log(record.Values());
+    console.log(record);
   })
-  .on('end', (summary) => {
-    console.log(summary);
+  .on('end', () => {
     console.log('### END ###');
   });
 
 (async () => {
   try {
-    // TODO(gitbuda): Design the correct interface. Connect should also return
-    // a promise.
-    const connection = memgraph.Connect({ host: 'localhost', port: 7687 });
+    const connection = await memgraph.Connect({
+      host: 'localhost',
+      port: 7687,
+    });
 
     await connection.ExecuteAndFetchAll(query.DELETE_ALL);
 
-    const result = await connection.ExecuteLazy(
+    const cursor = await connection.ExecuteLazy(
       `UNWIND [0, 1] AS item RETURN "value_x2" AS x, "value_y2" AS y;`,
+      {},
+      { batchSize: 1 },
     );
-    console.log(result);
-    // TODO(gitbuda): Figure out how to hide the bind call from a user.
-    result.Stream(emitter.emit.bind(emitter));
+    emitter.emit('start');
+    for await (const record of cursor) {
+      emitter.emit('record', record);
+    }
+    emitter.emit('end');
   } catch (e) {
     console.log(e);
   }
@@ -12,22 +12,277 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+/// <reference types="node" />
+import { Readable } from "stream";
+import { ResultSnapshot } from "./lib/snapshot";
+export class Cursor {
+    constructor(client: any, batchSize?: number, options?: any);
+    client: any;
+    batchSize: number;
+    options: any;
+    exhausted: boolean;
+    /**
+      * Fetch the next batch of records.
+      * @return {Promise<Array>} An empty array once all records are consumed.
+      */
+    FetchBatch(): Promise<any[]>;
+    /**
+      * Discard all records which are not yet fetched.
+      */
+    Close(): Promise<void>;
+    [Symbol.asyncIterator](): AsyncGenerator<any, void, unknown>;
+}
+export class RecordStream extends Readable {
+    constructor(client: any, query: string, params: any, options: any);
+    cursor: Cursor;
+    reading: boolean;
+    executed: Promise<any>;
+}
+export class Statement {
+    constructor(statement: any);
+    statement: any;
+    get query(): string;
+    Execute(params?: {}): Promise<any>;
+    ExecuteAndFetchAll(params?: {}, options?: any): Promise<any>;
+    ExecuteAndDiscardAll(params?: {}): Promise<any>;
+}
 export class Connection {
     constructor(client: any);
     client: any;
+    options: any;
     Execute(query: any, params?: {}): Promise<any>;
-    FetchAll(): Promise<any>;
+    FetchAll(options?: any): Promise<any>;
     DiscardAll(): Promise<any>;
+    /**
+      * Fetch the next record of the executed query.
+      * @return {Promise<Array|null>} null once all records are consumed.
+      */
+    FetchOne(options?: any): Promise<any[] | null>;
+    /**
+      * Fetch all records in the column-major form. Returns `{ rowCount,
+      * columns }` where each column is `{ type, values, validity }`. Integer
+      * and float columns are returned as `BigInt64Array` and `Float64Array`,
+      * any other column as a plain Array. `validity` is a `Uint8Array` bitmap
+      * (bit `i % 8` of byte `i / 8` is set if row `i` isn't null) or null when
+      * the column has no nulls. An empty result has an empty `mixed` column
+      * per field.
+      */
+    FetchColumns(options?: any): Promise<any>;
+    /**
+      * Fetch all records as a flat binary snapshot. The records are serialized
+      * on the worker thread, the main thread receives a single ArrayBuffer.
+      * Use `new ResultSnapshot(buffer)` to read the rows, e.g. after
+      * transferring the buffer to a worker_thread.
+      * @return {Promise<ArrayBuffer>}
+      */
+    FetchSnapshot(): Promise<ArrayBuffer>;
     Begin(): Promise<any>;
     Commit(): Promise<any>;
     Rollback(): Promise<any>;
+    /**
+      * Prepare a query which is executed many times with different parameters.
+      * The statement is bound to this connection.
+      * @param {string} query - The query to prepare.
+      * @return {Statement}
+      */
+    Prepare(query: string): Statement;
+    ExecuteAndFetchAll(query: any, params?: {}, options?: any): Promise<any>;
+    ExecuteAndDiscardAll(query: any, params?: {}): Promise<any>;
+    /**
+      * Execute many queries and fetch all their records with a single native
+      * call, e.g. one lookup per id. Each query gets its own result, a failed
+      * query doesn't stop the others. With `transactional` the queries run in
+      * one transaction: the queries after a failed one aren't executed and the
+      * transaction is rolled back.
+      * @param {Array} statements - `{ query, params }` objects.
+      * @param {Object} options - `{ transactional }` and the conversion
+      * options, see SetOptions. `timeSlice` doesn't apply.
+      * @return {Promise<Array>} `{ records }` or `{ error }` per statement.
+      */
+    ExecuteMany(statements: {
+        query: string;
+        params?: any;
+    }[], options?: any): Promise<{
+        records?: any[][];
+        error?: Error;
+    }[]>;
+    ExecuteAndFetchColumns(query: any, params?: {}, options?: any): Promise<any>;
+    /**
+      * Execute a query and return its result as a ResultSnapshot which decodes
+      * the rows and cells on access.
+      * @param {string} query - The query to execute.
+      * @param {Object} params - The query parameters.
+      * @param {Object} options - `{ integers }`, on top of the connection
+      * options, see SetOptions.
+      * @return {Promise<ResultSnapshot>}
+      */
+    ExecuteAndFetchSnapshot(query: string, params?: any, options?: any): Promise<ResultSnapshot>;
+    /**
+      * Execute a query and return a Cursor which can be consumed with
+      * `for await (const record of cursor)`.
+      * @param {string} query - The query to execute.
+      * @param {Object} params - The query parameters.
+      * @param {Object} options - `{ batchSize }`, the number of records pulled
+      * from the native side at once, and the conversion options, see
+      * SetOptions.
+      */
+    ExecuteLazy(query: string, params?: any, options?: any): Promise<Cursor>;
+    /**
+      * Execute a query and stream its records, e.g. into
+      * `stream.pipeline(connection.Stream(query), toNdjson, response)`.
+      * Records are fetched only as the consumer reads them.
+      * @param {string} query - The query to execute.
+      * @param {Object} params - The query parameters.
+      * @param {Object} options - `{ highWaterMark }` (default 1000), the number
+      * of records buffered and fetched at once, and the conversion options,
+      * see SetOptions.
+      * @return {Readable} An objectMode stream of records.
+      */
+    Stream(query: string, params?: any, options?: any): RecordStream;
+    /**
+      * Write the rows in batches, each batch is passed to the query as the
+      * `$batch` parameter, e.g. `UNWIND $batch AS row CREATE (:Node {id:
+      * row.id})`. The batches are pipelined: up to `maxInFlight` of them are
+      * queued on the connection at once.
+      * @param {string} query - The query executed once per batch.
+      * @param {Array} rows - The rows to write.
+      * @param {Object} options - `{ batchSize, maxInFlight, transactional,
+      * params, onProgress }`. `params` are passed to every batch next to
+      * `batch`. With `transactional` all batches run in one transaction which
+      * is rolled back, and the first batch error rethrown, if any batch fails.
+      * `onProgress` is called after every batch.
+      * @return {Promise<Object>} `{ batches, rows, writtenBatches, writtenRows,
+      * errors }`, every error is `{ batch, offset, error }`.
+      */
+    BulkWrite(query: string, rows: any[], options?: any): Promise<any>;
+    /**
+      * Run a write transaction and retry it, with a jittered exponential
+      * backoff, if it fails on a conflict with a concurrent transaction.
+      * `work` is either an async function, which gets this connection and runs
+      * between Begin and Commit (rolled back if it throws), or an array of
+      * `{ query, params }` statements. The statements are sent together with
+      * BEGIN and COMMIT as a single call, see ExecuteMany.
+      * @param {function(Connection): Promise|Array} work - The transaction.
+      * @param {Object} options - `{ retries, retryDelay }` (3 and 50 ms by
+      * default) and, for statements, the conversion options, see SetOptions.
+      * @return {Promise} The value returned by the function, or the records
+      * of every statement.
+      */
+    Transaction<T>(work: ((tx: Connection) => Promise<T>) | {
+        query: string;
+        params?: any;
+    }[], options?: any): Promise<T | any[][][]>;
+    runStatements(statements: any[], decodeOptions: any): Promise<any[][][]>;
+    runTransactionFunction<T>(work: (tx: Connection) => Promise<T>): Promise<T>;
+    /**
+      * Set how the fetched values are converted. The fetch calls accept the
+      * same object as their last argument to override it for a single call.
+      * @param {Object} options - `{ integers, lazyGraph, typedLists,
+      * timeSlice }`.
+      * `integers` is one of `'bigint'` (default), `'number'` (loses precision
+      * beyond 2^53) or `'auto'` (a BigInt only for values beyond 2^53); it
+      * applies to values, ids and temporal fields, but not to the typed arrays
+      * of FetchColumns. With `lazyGraph` nodes, relationships and paths are
+      * returned as native-backed objects which convert labels, properties,
+      * nodes and relationships on first access (`toJSON()` returns the plain
+      * object). A retained lazy object keeps the whole fetched result in
+      * memory. With `typedLists` non-empty lists of only floats or only
+      * integers are returned as `Float64Array` or `BigInt64Array`. With
+      * `timeSlice` (microseconds, 0 by default) FetchAll and
+      * ExecuteAndFetchAll convert a large result in slices of about that
+      * duration and yield to the event loop in between.
+      */
+    SetOptions(options: any): void;
+    /**
+      * Counters and latency histograms of this connection since it was opened
+      * or since the last ResetStats. The histograms are `{ count, min, mean,
+      * p50, p90, p99, p999, max }` in milliseconds, one per phase of a call:
+      * `queueWait` (behind the previous calls of the connection),
+      * `threadpoolWait` (for a free libuv threadpool thread, see
+      * UV_THREADPOOL_SIZE), `network` (the round trips on the worker thread),
+      * `encoding` (the query parameters) and `conversion` (the result into JS
+      * values, on the main thread).
+      * @return {Object} `{ queries, commands, errors, rows, bytes, queueWait,
+      * threadpoolWait, network, encoding, conversion }`.
+      */
+    Stats(): any;
+    ResetStats(): void;
+    /**
+      * Close a connection of the event loop engine right away. A native
+      * connection is closed once it's garbage collected.
+      */
+    Close(): void;
+}
+export class Pool {
+    constructor(pool: any, options?: any);
+    pool: any;
+    options: any;
+    /**
+      * Wait for a free Connection. Waiters are served in the FIFO order.
+      * @return {Promise<Connection>}
+      */
+    Acquire(): Promise<Connection>;
+    /**
+      * Return the Connection to the pool.
+      * @param {Connection} connection - A Connection returned by Acquire.
+      * @param {boolean} discard - Close the Connection instead of reusing it,
+      * e.g. because it's in an unknown state after an error.
+      */
+    Release(connection: Connection, discard?: boolean): void;
+    /**
+      * Lease a Connection for the duration of the callback.
+      * @param {function(Connection): Promise} callback
+      */
+    Run(callback: (arg0: Connection) => Promise<any>): Promise<any>;
     ExecuteAndFetchAll(query: any, params?: {}): Promise<any>;
+    ExecuteAndDiscardAll(query: any, params?: {}): Promise<any>;
+    ExecuteMany(statements: {
+        query: string;
+        params?: any;
+    }[], options?: any): Promise<{
+        records?: any[][];
+        error?: Error;
+    }[]>;
+    Transaction<T>(work: ((tx: Connection) => Promise<T>) | {
+        query: string;
+        params?: any;
+    }[], options?: any): Promise<T | any[][][]>;
+    /**
+      * Write the rows in batches, see Connection.BulkWrite. Without
+      * `transactional` the batches are spread over up to `maxInFlight` pooled
+      * connections, otherwise a single connection writes all of them.
+      */
+    BulkWrite(query: any, rows: any, options?: {}): Promise<any>;
+    Status(): any;
+    /**
+      * The Stats of the open connections merged together, see
+      * Connection.Stats.
+      */
+    Stats(): any;
+    ResetStats(): void;
+    Close(): void;
 }
 export namespace Memgraph {
     export function Client_1(): any;
     export { Client_1 as Client };
-    export function Connect_1(params: any): Promise<Connection>;
+    /**
+      * Connect to Memgraph.
+      * @param {Object} params - Connect arguments `{ host, port, username,
+      * password, client_name, use_ssl, io_thread, read_ahead, event_loop
+      * }`. With `io_thread` the connection executes its calls on a thread of
+      * its own instead of the libuv threadpool, so that slow queries don't
+      * hold threadpool threads. `read_ahead` (default 256) is the number of
+      * records FetchOne fetches ahead, 0 fetches one record per call. With
+      * `event_loop` the connection speaks Bolt over a non-blocking socket on
+      * the event loop and uses no thread at all, see lib/bolt.js
+      * (FetchColumns and FetchSnapshot aren't supported, `lazyGraph` is
+      * ignored).
+      * @param {Object} options - Conversion options, see
+      * Connection.SetOptions.
+      */
+    export function Connect_1(params: any, options?: any): Promise<Connection>;
     export { Connect_1 as Connect };
+    export function CreatePool(params?: any, options?: any): Promise<Pool>;
 }
 /**
   * Create Memgraph compatible date object.
@@ -73,4 +328,9 @@ export function createMgDuration(days: number, seconds: number, nanoseconds: num
 };
 import Client = Memgraph.Client;
 import Connect = Memgraph.Connect;
-export { Memgraph as default, Client, Connect };
+import CreatePool = Memgraph.CreatePool;
+export { ResultSnapshot };
+export const Node: any;
+export const Relationship: any;
+export const Path: any;
+export { Memgraph as default, Client, Connect, CreatePool };
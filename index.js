@@ -12,8 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+const { Readable } = require('stream');
 const Bindings = require('bindings')('nodemgclient');
 const pjson = require('./package.json');
+const { BoltClient } = require('./lib/bolt');
+const { ResultSnapshot } = require('./lib/snapshot');
 
 // The purpose of create functions is to simplify creation of Memgraph specific
 // data types, e.g. temporal types.
@@ -72,25 +75,285 @@ function createMgDuration(days, seconds, nanoseconds) {
   }
 }
 
+// Number of records a Cursor pulls from the native side in one go.
+const DEFAULT_CURSOR_BATCH_SIZE = 1000;
+// Number of records a RecordStream buffers, and fetches in one go.
+const DEFAULT_STREAM_HIGH_WATER_MARK = 1000;
+
+// Number of rows passed as the $batch parameter of a single BulkWrite query.
+const DEFAULT_BULK_BATCH_SIZE = 1000;
+// Number of BulkWrite batches issued before the first one completes.
+const DEFAULT_BULK_MAX_IN_FLIGHT = 4;
+
+// Number of times Transaction retries a conflicting transaction.
+const DEFAULT_TRANSACTION_RETRIES = 3;
+// Base of the exponential backoff between the retries, in milliseconds.
+const DEFAULT_TRANSACTION_RETRY_DELAY = 50;
+
+// Memgraph aborts the second of two conflicting write transactions, which
+// then succeeds when it's run again. The native client only has the message.
+function isTransactionConflict(error) {
+  return (typeof error.code === 'string' &&
+    error.code.includes('TransientError')) ||
+    /conflicting transactions/i.test(error.message);
+}
+
+// Exponential backoff with full jitter, so the retries of the conflicting
+// transactions don't collide again.
+function transactionRetryDelay(attempt, retryDelay) {
+  return Math.random() * retryDelay * 2 ** attempt;
+}
+
+// The batch size of the BulkWrite options. Throws if it's invalid.
+function bulkBatchSize(options) {
+  const { batchSize = DEFAULT_BULK_BATCH_SIZE } = options;
+  if (!Number.isInteger(batchSize) || batchSize <= 0) {
+    throw new Error('The batch size has to be a positive integer.');
+  }
+  return batchSize;
+}
+
+// Slices the rows into batches and runs them with at most `lanes` batches in
+// flight. Each lane awaits only its own batch, so the next batches are already
+// queued on the native side while one is executed. The errors are collected
+// per batch; with stopOnError no new batch is started after the first one.
+// finishLane is called once a lane has no more batches to run.
+async function runBulkBatches(rows, options, lanes, executeBatch,
+  finishLane) {
+  const batchSize = bulkBatchSize(options);
+  const { onProgress } = options;
+  const batchCount = Math.ceil(rows.length / batchSize);
+  const report = {
+    batches: batchCount,
+    rows: rows.length,
+    writtenBatches: 0,
+    writtenRows: 0,
+    errors: [],
+  };
+  let nextBatch = 0;
+  // Set once a lane throws, e.g. from onProgress.
+  let aborted = false;
+  const runLane = async (lane) => {
+    try {
+      await runLaneBatches(lane);
+    } finally {
+      if (finishLane) {
+        await finishLane(lane);
+      }
+    }
+  };
+  const runLaneBatches = async (lane) => {
+    while (nextBatch < batchCount && !aborted) {
+      if (options.stopOnError && report.errors.length > 0) {
+        return;
+      }
+      const index = nextBatch++;
+      const offset = index * batchSize;
+      const batch = rows.slice(offset, offset + batchSize);
+      try {
+        await executeBatch(lane, batch);
+        report.writtenBatches += 1;
+        report.writtenRows += batch.length;
+      } catch (error) {
+        report.errors.push({ batch: index, offset: offset, error: error });
+      }
+      if (onProgress) {
+        onProgress({
+          batches: batchCount,
+          rows: rows.length,
+          writtenBatches: report.writtenBatches,
+          writtenRows: report.writtenRows,
+          failedBatches: report.errors.length,
+        });
+      }
+    }
+  };
+  const laneCount = Math.min(lanes, batchCount);
+  await Promise.all(Array.from({ length: laneCount }, (_, lane) =>
+    runLane(lane).catch((error) => {
+      aborted = true;
+      throw error;
+    })));
+  return report;
+}
+
+// Cursor reads the result of an already executed query in batches. Each batch
+// costs a single native worker hop, which keeps the memory usage bounded
+// without paying one Promise per record.
+class Cursor {
+  constructor(client, batchSize = DEFAULT_CURSOR_BATCH_SIZE, options) {
+    this.client = client;
+    this.batchSize = batchSize;
+    this.options = options;
+    this.exhausted = false;
+  }
+
+  /**
+    * Fetch the next batch of records.
+    * @return {Promise<Array>} An empty array once all records are consumed.
+    */
+  async FetchBatch() {
+    if (this.exhausted) {
+      return [];
+    }
+    const batch = await this.client.FetchBatch(this.batchSize, this.options);
+    if (batch.length < this.batchSize) {
+      this.exhausted = true;
+    }
+    return batch;
+  }
+
+  /**
+    * Discard all records which are not yet fetched.
+    */
+  async Close() {
+    if (!this.exhausted) {
+      this.exhausted = true;
+      await this.client.DiscardAll();
+    }
+  }
+
+  async *[Symbol.asyncIterator]() {
+    try {
+      while (!this.exhausted) {
+        for (const record of await this.FetchBatch()) {
+          yield record;
+        }
+      }
+    } finally {
+      // Makes the connection usable again if the iteration stopped early.
+      await this.Close();
+    }
+  }
+}
+
+// RecordStream is an objectMode Readable of the records of a query. A batch
+// of up to highWaterMark records is fetched only when the stream asks for
+// more, so a slow consumer stops the reads from the socket (and the server
+// is held back by TCP) instead of the result piling up in memory.
+class RecordStream extends Readable {
+  constructor(client, query, params, options) {
+    const {
+      highWaterMark = DEFAULT_STREAM_HIGH_WATER_MARK,
+      ...decodeOptions
+    } = options;
+    if (!Number.isInteger(highWaterMark) || highWaterMark <= 0) {
+      throw new Error('The high water mark has to be a positive integer.');
+    }
+    super({ objectMode: true, highWaterMark: highWaterMark });
+    this.cursor = new Cursor(client, highWaterMark, decodeOptions);
+    this.reading = false;
+    // Queued right away, so it runs before the calls issued after it.
+    this.executed = client.Execute(query, params);
+    this.executed.catch((error) => this.destroy(error));
+  }
+
+  _read() {
+    if (this.reading) {
+      return;
+    }
+    this.reading = true;
+    this.executed
+      .then(() => this.cursor.FetchBatch())
+      .then((batch) => {
+        this.reading = false;
+        for (const record of batch) {
+          this.push(record);
+        }
+        if (this.cursor.exhausted) {
+          this.push(null);
+        }
+      })
+      .catch((error) => this.destroy(error));
+  }
+
+  _destroy(error, callback) {
+    // Makes the connection usable again if the stream stopped early.
+    this.executed
+      .then(() => this.cursor.Close())
+      .then(() => callback(error), () => callback(error));
+  }
+}
+
+// Statement is a query prepared by Connection.Prepare. The query text is
+// encoded once and the parameter keys are cached after the first execution,
+// calls with the same keys skip their conversion. Only the cached keys are
+// sent while all of them are present, so pass the same keys every time.
+class Statement {
+  constructor(statement) {
+    this.statement = statement;
+  }
+
+  get query() {
+    return this.statement.query;
+  }
+
+  async Execute(params={}) {
+    return await this.statement.Execute(params);
+  }
+
+  async ExecuteAndFetchAll(params={}, options) {
+    return await this.statement.ExecuteAndFetchAll(params, options);
+  }
+
+  async ExecuteAndDiscardAll(params={}) {
+    return await this.statement.ExecuteAndDiscardAll(params);
+  }
+}
+
 // This class exists becuase of additional logic that is easier to implement in
 // JavaScript + to extend the implementation with easy to use primitives.
 class Connection {
   constructor(client) {
     this.client = client;
+    // The options set by SetOptions, for the results converted in JS.
+    this.options = {};
   }
 
   async Execute(query, params={}) {
     return await this.client.Execute(query, params);
   }
 
-  async FetchAll() {
-    return await this.client.FetchAll();
+  async FetchAll(options) {
+    return await this.client.FetchAll(options);
   }
 
   async DiscardAll() {
     return await this.client.DiscardAll();
   }
 
+  /**
+    * Fetch the next record of the executed query.
+    * @return {Promise<Array|null>} null once all records are consumed.
+    */
+  async FetchOne(options) {
+    return await this.client.FetchOne(options);
+  }
+
+  /**
+    * Fetch all records in the column-major form. Returns `{ rowCount,
+    * columns }` where each column is `{ type, values, validity }`. Integer
+    * and float columns are returned as `BigInt64Array` and `Float64Array`,
+    * any other column as a plain Array. `validity` is a `Uint8Array` bitmap
+    * (bit `i % 8` of byte `i / 8` is set if row `i` isn't null) or null when
+    * the column has no nulls. An empty result has an empty `mixed` column
+    * per field.
+    */
+  async FetchColumns(options) {
+    return await this.client.FetchColumns(options);
+  }
+
+  /**
+    * Fetch all records as a flat binary snapshot. The records are serialized
+    * on the worker thread, the main thread receives a single ArrayBuffer.
+    * Use `new ResultSnapshot(buffer)` to read the rows, e.g. after
+    * transferring the buffer to a worker_thread.
+    * @return {Promise<ArrayBuffer>}
+    */
+  async FetchSnapshot() {
+    return await this.client.FetchSnapshot();
+  }
+
   async Begin() {
     return await this.client.Begin();
   }
@@ -103,9 +366,387 @@ class Connection {
     return await this.client.Rollback();
   }
 
-  async ExecuteAndFetchAll(query, params={}) {
+  /**
+    * Prepare a query which is executed many times with different parameters.
+    * The statement is bound to this connection.
+    * @param {string} query - The query to prepare.
+    * @return {Statement}
+    */
+  Prepare(query) {
+    return new Statement(this.client.Prepare(query));
+  }
+
+  async ExecuteAndFetchAll(query, params={}, options) {
+    return await this.client.ExecuteAndFetchAll(query, params, options);
+  }
+
+  async ExecuteAndDiscardAll(query, params={}) {
+    return await this.client.ExecuteAndDiscardAll(query, params);
+  }
+
+  /**
+    * Execute many queries and fetch all their records with a single native
+    * call, e.g. one lookup per id. Each query gets its own result, a failed
+    * query doesn't stop the others. With `transactional` the queries run in
+    * one transaction: the queries after a failed one aren't executed and the
+    * transaction is rolled back.
+    * @param {Array} statements - `{ query, params }` objects.
+    * @param {Object} options - `{ transactional }` and the conversion
+    * options, see SetOptions. `timeSlice` doesn't apply.
+    * @return {Promise<Array>} `{ records }` or `{ error }` per statement.
+    */
+  async ExecuteMany(statements, options={}) {
+    const { transactional = false, ...decodeOptions } = options;
+    return await this.client.ExecuteMany(statements, transactional,
+      decodeOptions);
+  }
+
+  async ExecuteAndFetchColumns(query, params={}, options) {
+    // Both calls end up in the same native batch.
+    const [, columns] = await Promise.all([
+      this.client.Execute(query, params),
+      this.client.FetchColumns(options),
+    ]);
+    return columns;
+  }
+
+  /**
+    * Execute a query and return its result as a ResultSnapshot which decodes
+    * the rows and cells on access.
+    * @param {string} query - The query to execute.
+    * @param {Object} params - The query parameters.
+    * @param {Object} options - `{ integers }`, on top of the connection
+    * options, see SetOptions.
+    * @return {Promise<ResultSnapshot>}
+    */
+  async ExecuteAndFetchSnapshot(query, params={}, options={}) {
+    // Both calls end up in the same native batch.
+    const [, buffer] = await Promise.all([
+      this.client.Execute(query, params),
+      this.client.FetchSnapshot(),
+    ]);
+    return new ResultSnapshot(buffer, { ...this.options, ...options });
+  }
+
+  /**
+    * Execute a query and return a Cursor which can be consumed with
+    * `for await (const record of cursor)`.
+    * @param {string} query - The query to execute.
+    * @param {Object} params - The query parameters.
+    * @param {Object} options - `{ batchSize }`, the number of records pulled
+    * from the native side at once, and the conversion options, see
+    * SetOptions.
+    */
+  async ExecuteLazy(query, params={}, options={}) {
+    const { batchSize, ...decodeOptions } = options;
     await this.client.Execute(query, params);
-    return await this.client.FetchAll();
+    return new Cursor(this.client, batchSize, decodeOptions);
+  }
+
+  /**
+    * Execute a query and stream its records, e.g. into
+    * `stream.pipeline(connection.Stream(query), toNdjson, response)`.
+    * Records are fetched only as the consumer reads them.
+    * @param {string} query - The query to execute.
+    * @param {Object} params - The query parameters.
+    * @param {Object} options - `{ highWaterMark }` (default 1000), the number
+    * of records buffered and fetched at once, and the conversion options,
+    * see SetOptions.
+    * @return {Readable} An objectMode stream of records.
+    */
+  Stream(query, params={}, options={}) {
+    return new RecordStream(this.client, query, params, options);
+  }
+
+  /**
+    * Write the rows in batches, each batch is passed to the query as the
+    * `$batch` parameter, e.g. `UNWIND $batch AS row CREATE (:Node {id:
+    * row.id})`. The batches are pipelined: up to `maxInFlight` of them are
+    * queued on the connection at once.
+    * @param {string} query - The query executed once per batch.
+    * @param {Array} rows - The rows to write.
+    * @param {Object} options - `{ batchSize, maxInFlight, transactional,
+    * params, onProgress }`. `params` are passed to every batch next to
+    * `batch`. With `transactional` all batches run in one transaction which
+    * is rolled back, and the first batch error rethrown, if any batch fails.
+    * `onProgress` is called after every batch.
+    * @return {Promise<Object>} `{ batches, rows, writtenBatches, writtenRows,
+    * errors }`, every error is `{ batch, offset, error }`.
+    */
+  async BulkWrite(query, rows, options={}) {
+    const { maxInFlight = DEFAULT_BULK_MAX_IN_FLIGHT, params = {} } = options;
+    const executeBatch = (lane, batch) =>
+      this.client.ExecuteAndDiscardAll(query, { ...params, batch: batch });
+    if (!options.transactional) {
+      return await runBulkBatches(rows, options, maxInFlight, executeBatch);
+    }
+    // Invalid options shouldn't leave a transaction open.
+    bulkBatchSize(options);
+    await this.client.Begin();
+    let report;
+    try {
+      report = await runBulkBatches(rows, { ...options, stopOnError: true },
+        maxInFlight, executeBatch);
+      if (report.errors.length > 0) {
+        throw report.errors[0].error;
+      }
+    } catch (error) {
+      await this.client.Rollback();
+      throw error;
+    }
+    await this.client.Commit();
+    return report;
+  }
+
+  /**
+    * Run a write transaction and retry it, with a jittered exponential
+    * backoff, if it fails on a conflict with a concurrent transaction.
+    * `work` is either an async function, which gets this connection and runs
+    * between Begin and Commit (rolled back if it throws), or an array of
+    * `{ query, params }` statements. The statements are sent together with
+    * BEGIN and COMMIT as a single call, see ExecuteMany.
+    * @param {function(Connection): Promise|Array} work - The transaction.
+    * @param {Object} options - `{ retries, retryDelay }` (3 and 50 ms by
+    * default) and, for statements, the conversion options, see SetOptions.
+    * @return {Promise} The value returned by the function, or the records
+    * of every statement.
+    */
+  async Transaction(work, options={}) {
+    const {
+      retries = DEFAULT_TRANSACTION_RETRIES,
+      retryDelay = DEFAULT_TRANSACTION_RETRY_DELAY,
+      ...decodeOptions
+    } = options;
+    if (typeof work !== 'function' && !Array.isArray(work)) {
+      throw new Error(
+        'Transaction requires a function or an array of statements.');
+    }
+    if (!Number.isInteger(retries) || retries < 0) {
+      throw new Error('The retries have to be a non-negative integer.');
+    }
+    if (!Number.isFinite(retryDelay) || retryDelay < 0) {
+      throw new Error('The retry delay has to be a non-negative number.');
+    }
+    for (let attempt = 0; ; ++attempt) {
+      try {
+        if (Array.isArray(work)) {
+          return await this.runStatements(work, decodeOptions);
+        }
+        return await this.runTransactionFunction(work);
+      } catch (error) {
+        if (attempt >= retries || !isTransactionConflict(error)) {
+          throw error;
+        }
+        await new Promise((resolve) => setTimeout(resolve,
+          transactionRetryDelay(attempt, retryDelay)));
+      }
+    }
+  }
+
+  async runStatements(statements, decodeOptions) {
+    const results = await this.client.ExecuteMany(statements, true,
+      decodeOptions);
+    // The statements after the failed one weren't executed.
+    const failed = results.find((result) => result.error);
+    if (failed) {
+      throw failed.error;
+    }
+    return results.map((result) => result.records);
+  }
+
+  async runTransactionFunction(work) {
+    await this.client.Begin();
+    let result;
+    try {
+      result = await work(this);
+      await this.client.Commit();
+    } catch (error) {
+      // Fails if the server already aborted the transaction.
+      await this.client.Rollback().catch(() => {});
+      throw error;
+    }
+    return result;
+  }
+
+  /**
+    * Set how the fetched values are converted. The fetch calls accept the same
+    * object as their last argument to override it for a single call.
+    * @param {Object} options - `{ integers, lazyGraph, typedLists,
+    * timeSlice }`.
+    * `integers` is one of `'bigint'` (default), `'number'` (loses precision
+    * beyond 2^53) or `'auto'` (a BigInt only for values beyond 2^53); it
+    * applies to values, ids and temporal fields, but not to the typed arrays of
+    * FetchColumns. With `lazyGraph` nodes, relationships and paths are returned
+    * as native-backed objects which convert labels, properties, nodes and
+    * relationships on first access (`toJSON()` returns the plain object). A
+    * retained lazy object keeps the whole fetched result in memory. With
+    * `typedLists` non-empty lists of only floats or only integers are returned
+    * as `Float64Array` or `BigInt64Array`. With `timeSlice` (microseconds, 0
+    * by default) FetchAll and ExecuteAndFetchAll convert a large result in
+    * slices of about that duration and yield to the event loop in between.
+    */
+  SetOptions(options) {
+    this.client.SetOptions(options);
+    this.options = { ...this.options, ...options };
+  }
+
+  /**
+    * Counters and latency histograms of this connection since it was opened
+    * or since the last ResetStats. The histograms are `{ count, min, mean,
+    * p50, p90, p99, p999, max }` in milliseconds, one per phase of a call:
+    * `queueWait` (behind the previous calls of the connection),
+    * `threadpoolWait` (for a free libuv threadpool thread, see
+    * UV_THREADPOOL_SIZE), `network` (the round trips on the worker thread),
+    * `encoding` (the query parameters) and `conversion` (the result into JS
+    * values, on the main thread).
+    * @return {Object} `{ queries, commands, errors, rows, bytes, queueWait,
+    * threadpoolWait, network, encoding, conversion }`.
+    */
+  Stats() {
+    return this.client.Stats();
+  }
+
+  ResetStats() {
+    this.client.ResetStats();
+  }
+
+  /**
+    * Close a connection of the event loop engine right away. A native
+    * connection is closed once it's garbage collected.
+    */
+  Close() {
+    if (this.client.Close) {
+      this.client.Close();
+    }
+  }
+}
+
+// Event loop engine connections which weren't closed are closed once the
+// Connection is garbage collected, the same as the native ones.
+const boltClients = typeof FinalizationRegistry === 'undefined' ? null :
+  new FinalizationRegistry((client) => client.Close());
+
+// Pool leases one Connection per operation or transaction. A leased
+// Connection is used exclusively by its holder until it's released.
+class Pool {
+  constructor(pool, options) {
+    this.pool = pool;
+    this.options = options;
+  }
+
+  /**
+    * Wait for a free Connection. Waiters are served in the FIFO order.
+    * @return {Promise<Connection>}
+    */
+  async Acquire() {
+    const connection = new Connection(await this.pool.Acquire());
+    if (this.options) {
+      connection.SetOptions(this.options);
+    }
+    return connection;
+  }
+
+  /**
+    * Return the Connection to the pool.
+    * @param {Connection} connection - A Connection returned by Acquire.
+    * @param {boolean} discard - Close the Connection instead of reusing it,
+    * e.g. because it's in an unknown state after an error.
+    */
+  Release(connection, discard=false) {
+    this.pool.Release(connection.client, discard);
+  }
+
+  /**
+    * Lease a Connection for the duration of the callback.
+    * @param {function(Connection): Promise} callback
+    */
+  async Run(callback) {
+    const connection = await this.Acquire();
+    try {
+      return await callback(connection);
+    } finally {
+      this.Release(connection);
+    }
+  }
+
+  async ExecuteAndFetchAll(query, params={}) {
+    return await this.Run((connection) =>
+      connection.ExecuteAndFetchAll(query, params));
+  }
+
+  async ExecuteAndDiscardAll(query, params={}) {
+    return await this.Run((connection) =>
+      connection.ExecuteAndDiscardAll(query, params));
+  }
+
+  async ExecuteMany(statements, options={}) {
+    return await this.Run((connection) =>
+      connection.ExecuteMany(statements, options));
+  }
+
+  async Transaction(work, options={}) {
+    return await this.Run((connection) =>
+      connection.Transaction(work, options));
+  }
+
+  /**
+    * Write the rows in batches, see Connection.BulkWrite. Without
+    * `transactional` the batches are spread over up to `maxInFlight` pooled
+    * connections, otherwise a single connection writes all of them.
+    */
+  async BulkWrite(query, rows, options={}) {
+    if (options.transactional) {
+      return await this.Run((connection) =>
+        connection.BulkWrite(query, rows, options));
+    }
+    const { maxInFlight = DEFAULT_BULK_MAX_IN_FLIGHT, params = {} } = options;
+    // A lane holds a connection, more lanes than the pool can lease would
+    // wait for each other.
+    const lanes = Math.min(maxInFlight, this.Status().max);
+    const connections = [];
+    const release = async (lane) => {
+      const pending = connections[lane];
+      connections[lane] = null;
+      const connection = pending && await pending.catch(() => null);
+      if (connection) {
+        this.Release(connection);
+      }
+    };
+    try {
+      return await runBulkBatches(rows, options, lanes,
+        async (lane, batch) => {
+          if (!connections[lane]) {
+            connections[lane] = this.Acquire();
+          }
+          const connection = await connections[lane];
+          await connection.ExecuteAndDiscardAll(query,
+            { ...params, batch: batch });
+        }, release);
+    } finally {
+      for (let lane = 0; lane < connections.length; ++lane) {
+        await release(lane);
+      }
+    }
+  }
+
+  Status() {
+    return this.pool.Status();
+  }
+
+  /**
+    * The Stats of the open connections merged together, see
+    * Connection.Stats.
+    */
+  Stats() {
+    return this.pool.Stats();
+  }
+
+  ResetStats() {
+    this.pool.ResetStats();
+  }
+
+  Close() {
+    this.pool.Close();
   }
 }
 
@@ -113,19 +754,80 @@ const Memgraph = {
   Client: () => {
     return new Bindings.Client("nodemgclient/" + pjson.version);
   },
-  Connect: async (params) => {
-    let client = new Bindings.Client("nodemgclient/" + pjson.version);
-    // TODO(gitbuda): If the second client is not passed, execution blocks, check why.
-    client = await client.Connect(params);
-    return new Connection(client);
-  }
+  /**
+    * Connect to Memgraph.
+    * @param {Object} params - Connect arguments `{ host, port, username,
+    * password, client_name, use_ssl, io_thread, read_ahead, event_loop }`.
+    * With `io_thread` the connection executes its calls on a thread of its
+    * own instead of the libuv threadpool, so that slow queries don't hold
+    * threadpool threads. `read_ahead` (default 256) is the number of records
+    * FetchOne fetches ahead, 0 fetches one record per call. With
+    * `event_loop` the connection speaks Bolt over a non-blocking socket on
+    * the event loop and uses no thread at all, see lib/bolt.js (FetchColumns
+    * and FetchSnapshot aren't supported, `lazyGraph` is ignored).
+    * @param {Object} options - Conversion options, see
+    * Connection.SetOptions.
+    */
+  Connect: async (params, options) => {
+    const userAgent = "nodemgclient/" + pjson.version;
+    let connection;
+    if (params && typeof params === 'object' && params.event_loop) {
+      const client = await new BoltClient(userAgent).Connect(params);
+      connection = new Connection(client);
+      if (boltClients) {
+        boltClients.register(connection, client);
+      }
+    } else {
+      if (params && typeof params === 'object' && 'event_loop' in params) {
+        const { event_loop: eventLoop, ...nativeParams } = params;
+        if (typeof eventLoop !== 'boolean') {
+          throw new Error('`event_loop` connect argument has to be boolean.');
+        }
+        params = nativeParams;
+      }
+      let client = new Bindings.Client(userAgent);
+      // TODO(gitbuda): If the second client is not passed, execution blocks, check why.
+      client = await client.Connect(params);
+      connection = new Connection(client);
+    }
+    if (options) {
+      connection.SetOptions(options);
+    }
+    return connection;
+  },
+  /**
+    * Create a Pool and open the minimal number of connections in parallel.
+    * @param {Object} params - Connect arguments extended with the `min`
+    * (default 1) and `max` (default 10) number of connections.
+    * @param {Object} options - Conversion options applied to every leased
+    * Connection, see Connection.SetOptions.
+    */
+  CreatePool: async (params={}, options) => {
+    const { min = 1, max = 10, ...connectParams } = params;
+    if ('event_loop' in connectParams) {
+      throw new Error('`event_loop` connect argument isn\'t supported by ' +
+        'CreatePool.');
+    }
+    const pool = new Bindings.Pool("nodemgclient/" + pjson.version);
+    await pool.Connect(connectParams, { min: min, max: max });
+    return new Pool(pool, options);
+  },
 }
 
 module.exports = {
   Connection,
+  Cursor,
+  Pool,
+  RecordStream,
+  ResultSnapshot,
+  Statement,
+  Node: Bindings.Node,
+  Relationship: Bindings.Relationship,
+  Path: Bindings.Path,
   default: Memgraph,
   Client: Memgraph.Client,
   Connect: Memgraph.Connect,
+  CreatePool: Memgraph.CreatePool,
   Memgraph: Memgraph,
   createMgDate: createMgDate,
   createMgLocalTime: createMgLocalTime,
@@ -0,0 +1,1132 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Event loop Bolt engine. It speaks Bolt (v1 and v4.x) over a non-blocking
+// net/tls socket, so a connection costs no thread, no matter how long its
+// queries run. It implements the method surface of the native Client, which
+// lets Connection, Statement and Cursor work on top of both engines, and
+// returns the same values as the native conversion (src/glue.cpp).
+//
+// Records are kept as received and decoded by the fetch call, with the
+// options of that call. When more than HIGH_WATER_MARK records wait for a
+// fetch, the socket is paused, which pushes back on the server over TCP.
+
+const net = require('net');
+const tls = require('tls');
+const {
+  Dechunker,
+  Packer,
+  Signature,
+  Structure,
+  Unpacker,
+  chunk,
+  encodeMessage,
+} = require('./packstream');
+const { ClientStats, elapsedNanoseconds } = require('./stats');
+
+const BOLT_MAGIC = 0x6060b017;
+// 4.1, 4.0 and 1.0, each as [0, 0, minor, major].
+const PROPOSED_VERSIONS = [0x0104, 0x0004, 0x0001, 0];
+
+const Message = {
+  HELLO: 0x01,
+  GOODBYE: 0x02,
+  ACK_FAILURE: 0x0e,
+  RESET: 0x0f,
+  RUN: 0x10,
+  BEGIN: 0x11,
+  COMMIT: 0x12,
+  ROLLBACK: 0x13,
+  DISCARD: 0x2f,
+  PULL: 0x3f,
+  SUCCESS: 0x70,
+  RECORD: 0x71,
+  IGNORED: 0x7e,
+  FAILURE: 0x7f,
+};
+
+const HIGH_WATER_MARK = 10000;
+const LOW_WATER_MARK = 1000;
+
+const INT64_MIN = -(2n ** 63n);
+const INT64_MAX = 2n ** 63n - 1n;
+const MAX_SAFE_INTEGER = BigInt(Number.MAX_SAFE_INTEGER);
+
+const MSG_CONNECT_FAILED =
+  'Connect failed. Ensure Memgraph is running and Client is properly ' +
+  'configured.';
+const MSG_WRONG_CONNECT_ARG =
+  'Wrong connect argument. An object containing { host, port, username, ' +
+  'password, client_name, use_ssl, io_thread, read_ahead, event_loop } is ' +
+  'required. All arguments are optional.';
+const MSG_WRONG_OPTIONS_ARG =
+  'Wrong options argument. An object containing { integers, lazyGraph, ' +
+  'typedLists, timeSlice } is required. All options are optional.';
+const MSG_EXECUTE_FAIL = 'Failed to execute a query.';
+const MSG_FETCH_ALL_FAIL = 'Failed to fetch all records.';
+const MSG_FETCH_ONE_FAIL = 'Failed to fetch one record.';
+const MSG_FETCH_BATCH_FAIL = 'Failed to fetch a batch of records.';
+const MSG_DISCARD_ALL_FAIL = 'Failed to discard all data.';
+const MSG_WRONG_STATEMENTS_ARG =
+  'ExecuteMany requires an array of { query, params } objects.';
+const MSG_NOT_EXECUTED = 'Not executed, the transaction was rolled back.';
+
+const CONNECT_ARGS = {
+  host: 'string',
+  port: 'number',
+  username: 'string',
+  password: 'string',
+  client_name: 'string',
+  use_ssl: 'boolean',
+  io_thread: 'boolean',
+  read_ahead: 'number',
+  event_loop: 'boolean',
+};
+
+function parseConnectParams(input, userAgent) {
+  const params = {
+    host: '127.0.0.1',
+    port: 7687,
+    username: '',
+    password: '',
+    client_name: userAgent,
+    use_ssl: false,
+  };
+  if (input === undefined) {
+    return params;
+  }
+  if (input === null || typeof input !== 'object') {
+    throw new Error(MSG_WRONG_CONNECT_ARG);
+  }
+  for (const [key, value] of Object.entries(input)) {
+    if (!(key in CONNECT_ARGS)) {
+      throw new Error(MSG_WRONG_CONNECT_ARG);
+    }
+    if (typeof value !== CONNECT_ARGS[key]) {
+      throw new Error(
+        `\`${key}\` connect argument has to be ${CONNECT_ARGS[key]}.`);
+    }
+    params[key] = value;
+  }
+  if (!Number.isInteger(params.port) || params.port < 0 ||
+      params.port > 65535) {
+    throw new Error(
+      '`port` connect argument out of range. Port has to be a number ' +
+      'between 0 and 65535.');
+  }
+  return params;
+}
+
+function parseDecodeOptions(input, defaults) {
+  const options = { ...defaults };
+  if (input === undefined) {
+    return options;
+  }
+  if (input === null || typeof input !== 'object') {
+    throw new Error(MSG_WRONG_OPTIONS_ARG);
+  }
+  for (const [key, value] of Object.entries(input)) {
+    if (key === 'integers') {
+      if (!['bigint', 'number', 'auto'].includes(value)) {
+        throw new Error(
+          "`integers` option has to be one of 'bigint', 'number' or 'auto'.");
+      }
+    } else if (key === 'timeSlice') {
+      if (typeof value !== 'number' || !(value >= 0 && value <= 3.6e9)) {
+        throw new Error('`timeSlice` option has to be a number of ' +
+          'microseconds between 0 and 3600000000.');
+      }
+    } else if (key === 'lazyGraph' || key === 'typedLists') {
+      if (typeof value !== 'boolean') {
+        throw new Error(`\`${key}\` option has to be boolean.`);
+      }
+    } else {
+      throw new Error(MSG_WRONG_OPTIONS_ARG);
+    }
+    options[key] = value;
+  }
+  return options;
+}
+
+function withReason(message, error) {
+  const output = new Error(`${message} ${error.message}`);
+  output.code = error.code;
+  return output;
+}
+
+// Encodes query parameters the same way as the native conversion.
+class ParamPacker extends Packer {
+  pack(value) {
+    if (typeof value === 'function' || typeof value === 'symbol') {
+      throw new Error('Unrecognized JavaScript value.');
+    }
+    super.pack(value);
+  }
+
+  integer(value) {
+    if (value < INT64_MIN || value > INT64_MAX) {
+      throw new Error('Fail to losslessly convert value to Memgraph int64.');
+    }
+    super.integer(value);
+  }
+
+  object(value) {
+    if (!('objectType' in value)) {
+      super.object(value);
+      return;
+    }
+    const field = (name, type) => {
+      const item = value[name];
+      if (typeof item !== 'bigint' || item < INT64_MIN || item > INT64_MAX) {
+        throw new Error(`Converting JS ${type} to Memgraph ${type} failed!`);
+      }
+      return item;
+    };
+    switch (value.objectType) {
+      case 'date':
+        this.pack(new Structure(Signature.DATE, [field('days', 'date')]));
+        break;
+      case 'local_time':
+        this.pack(new Structure(Signature.LOCAL_TIME,
+          [field('nanoseconds', 'local time')]));
+        break;
+      case 'local_date_time':
+        this.pack(new Structure(Signature.LOCAL_DATE_TIME, [
+          field('seconds', 'local date time'),
+          field('nanoseconds', 'local date time'),
+        ]));
+        break;
+      case 'duration':
+        this.pack(new Structure(Signature.DURATION, [
+          0n,
+          field('days', 'duration'),
+          field('seconds', 'duration'),
+          field('nanoseconds', 'duration'),
+        ]));
+        break;
+      default:
+        throw new Error('Unknown type of JS Object!');
+    }
+  }
+}
+
+function isIntegerMarker(marker) {
+  return marker <= 0x7f || marker >= 0xf0 ||
+    (marker >= 0xc8 && marker <= 0xcb);
+}
+
+// Maps the PackStream values to the JS values of the native conversion.
+class ValueDecoder extends Unpacker {
+  constructor(buffer, options) {
+    super(buffer);
+    this.integers = options.integers;
+    this.typedLists = options.typedLists;
+  }
+
+  integer(value) {
+    switch (this.integers) {
+      case 'number':
+        return Number(value);
+      case 'auto':
+        return value >= -MAX_SAFE_INTEGER && value <= MAX_SAFE_INTEGER ?
+          Number(value) : value;
+      default:
+        return value;
+    }
+  }
+
+  list(size) {
+    if (!this.typedLists || size === 0) {
+      return super.list(size);
+    }
+    // Elements are read raw until the list turns out not to be numeric.
+    const first = this.buffer[this.offset];
+    const floats = first === 0xc1;
+    if (!floats && !isIntegerMarker(first)) {
+      return super.list(size);
+    }
+    const values = floats ? new Float64Array(size) : new BigInt64Array(size);
+    for (let index = 0; index < size; ++index) {
+      const marker = this.buffer[this.offset];
+      if (floats ? marker !== 0xc1 : !isIntegerMarker(marker)) {
+        const output = new Array(size);
+        for (let done = 0; done < index; ++done) {
+          output[done] = floats ? values[done] : this.integer(values[done]);
+        }
+        for (let rest = index; rest < size; ++rest) {
+          output[rest] = this.unpack();
+        }
+        return output;
+      }
+      this.offset += 1;
+      if (floats) {
+        values[index] = this.buffer.readDoubleBE(this.offset);
+        this.offset += 8;
+      } else {
+        values[index] = this.readInteger(marker);
+      }
+    }
+    return values;
+  }
+
+  structure(signature, fields) {
+    switch (signature) {
+      case Signature.NODE:
+        return {
+          objectType: 'node',
+          id: fields[0],
+          labels: fields[1],
+          properties: fields[2],
+        };
+      case Signature.RELATIONSHIP:
+        return {
+          objectType: 'relationship',
+          id: fields[0],
+          startNodeId: fields[1],
+          endNodeId: fields[2],
+          edgeType: fields[3],
+          properties: fields[4],
+        };
+      case Signature.UNBOUND_RELATIONSHIP:
+        return {
+          objectType: 'relationship',
+          id: fields[0],
+          startNodeId: -1,
+          endNodeId: -1,
+          edgeType: fields[1],
+          properties: fields[2],
+        };
+      case Signature.PATH:
+        return this.path(fields[0], fields[1], fields[2]);
+      case Signature.DATE:
+        return {
+          objectType: 'date',
+          days: fields[0],
+          date: new Date(Number(fields[0]) * 24 * 60 * 60 * 1000),
+        };
+      case Signature.LOCAL_TIME:
+        return {
+          objectType: 'local_time',
+          nanoseconds: fields[0],
+        };
+      case Signature.LOCAL_DATE_TIME: {
+        // The same precision as the native conversion.
+        const milliseconds = BigInt(fields[0]) * 1000n +
+          BigInt(fields[1]) / 10000000n;
+        return {
+          objectType: 'local_date_time',
+          seconds: fields[0],
+          nanoseconds: fields[1],
+          date: new Date(Number(milliseconds)),
+        };
+      }
+      case Signature.DURATION:
+        return {
+          objectType: 'duration',
+          days: fields[1],
+          seconds: fields[2],
+          nanoseconds: fields[3],
+        };
+      default:
+        return super.structure(signature, fields);
+    }
+  }
+
+  // The sequence alternates the 1-based relationship index, negative for a
+  // relationship traversed against its direction, and the node index.
+  path(nodes, relationships, sequence) {
+    const outputNodes = [nodes[0]];
+    const outputRelationships = [];
+    let previous = nodes[0];
+    for (let index = 0; index + 1 < sequence.length; index += 2) {
+      const relationshipIndex = Number(sequence[index]);
+      const current = nodes[Number(sequence[index + 1])];
+      const reversed = relationshipIndex < 0;
+      outputRelationships.push({
+        ...relationships[Math.abs(relationshipIndex) - 1],
+        startNodeId: reversed ? current.id : previous.id,
+        endNodeId: reversed ? previous.id : current.id,
+      });
+      outputNodes.push(current);
+      previous = current;
+    }
+    return {
+      objectType: 'path',
+      nodes: outputNodes,
+      relationships: outputRelationships,
+    };
+  }
+}
+
+// A RECORD message is a Structure with a single list field, the values of
+// the record. The record itself is never a typed array.
+function decodeRecord(message, options) {
+  const decoder = new ValueDecoder(message, options);
+  decoder.offset = 2;
+  const size = decoder.size(decoder.u8(), 0x90, [0xd4, 0xd5, 0xd6]);
+  const record = new Array(size);
+  for (let index = 0; index < size; ++index) {
+    record[index] = decoder.unpack();
+  }
+  return record;
+}
+
+function isStatement(statement) {
+  return statement !== null && typeof statement === 'object' &&
+    typeof statement.query === 'string' && (statement.params === undefined ||
+    (statement.params !== null && typeof statement.params === 'object'));
+}
+
+function serverError(metadata = {}) {
+  const error = new Error(metadata.message || 'Unknown server failure.');
+  error.code = metadata.code;
+  return error;
+}
+
+// Records of one query, in the order of arrival. Filled by the responses to
+// the PULL (or DISCARD) request, consumed by the fetch calls.
+class ResultStream {
+  constructor(client) {
+    this.client = client;
+    this.records = [];
+    this.head = 0;
+    this.done = false;
+    this.error = null;
+    this.discarding = false;
+    this.waiter = null;
+  }
+
+  get buffered() {
+    return this.records.length - this.head;
+  }
+
+  record(message) {
+    ++this.client.stats.rows;
+    this.client.stats.bytes += message.length;
+    if (this.discarding) {
+      return;
+    }
+    this.records.push(message);
+    if (this.buffered >= HIGH_WATER_MARK && !this.waiter) {
+      this.client.pause();
+    }
+    this.wake();
+  }
+
+  // The rest of the data doesn't belong to this stream, so a paused socket
+  // is resumed.
+  success() {
+    this.done = true;
+    this.client.resume();
+    this.wake();
+  }
+
+  failure(error) {
+    this.error = error;
+    this.done = true;
+    this.client.resume();
+    this.wake();
+  }
+
+  wake() {
+    if (this.waiter) {
+      const waiter = this.waiter;
+      this.waiter = null;
+      waiter();
+    }
+  }
+
+  wait() {
+    this.client.resume();
+    return new Promise((resolve) => {
+      this.waiter = resolve;
+    });
+  }
+
+  take() {
+    const message = this.records[this.head];
+    this.records[this.head++] = undefined;
+    if (this.head > LOW_WATER_MARK && this.head * 2 > this.records.length) {
+      this.records = this.records.slice(this.head);
+      this.head = 0;
+    }
+    if (this.buffered < LOW_WATER_MARK) {
+      this.client.resume();
+    }
+    return message;
+  }
+
+  /** @return {Promise<Buffer|null>} The next record, null at the end. */
+  async next() {
+    while (this.buffered === 0 && !this.done) {
+      await this.wait();
+    }
+    if (this.buffered > 0) {
+      return this.take();
+    }
+    if (this.error) {
+      throw this.error;
+    }
+    return null;
+  }
+
+  /** @return {Promise<Array<Buffer>>} All the remaining records. */
+  async all() {
+    // The socket isn't paused while a waiter is set.
+    while (!this.done) {
+      await this.wait();
+    }
+    if (this.error) {
+      throw this.error;
+    }
+    const records = this.records.slice(this.head);
+    this.records = [];
+    this.head = 0;
+    return records;
+  }
+
+  async discard() {
+    this.discarding = true;
+    this.records = [];
+    this.head = 0;
+    while (!this.done) {
+      await this.wait();
+    }
+  }
+}
+
+// A query bound to the client, the counterpart of the native Statement.
+class PreparedQuery {
+  constructor(client, query) {
+    this.client = client;
+    this.query = query;
+  }
+
+  Execute(params) {
+    return this.client.Execute(this.query, params);
+  }
+
+  ExecuteAndFetchAll(params, options) {
+    return this.client.ExecuteAndFetchAll(this.query, params, options);
+  }
+
+  ExecuteAndDiscardAll(params) {
+    return this.client.ExecuteAndDiscardAll(this.query, params);
+  }
+}
+
+class BoltClient {
+  constructor(userAgent) {
+    this.userAgent = userAgent;
+    this.socket = null;
+    this.major = null;
+    this.dechunker = new Dechunker();
+    // Handlers of the sent requests, in the order of the responses.
+    this.handlers = [];
+    this.tail = Promise.resolve();
+    this.pending = 0;
+    this.paused = false;
+    this.stream = null;
+    this.options = { integers: 'bigint', lazyGraph: false, typedLists: false,
+      timeSlice: 0 };
+    this.stats = new ClientStats();
+  }
+
+  /**
+    * @param {Object} params - The connect arguments of the native Client.
+    * @return {Promise<BoltClient>} This client, once the HELLO succeeded.
+    */
+  async Connect(params) {
+    if (this.socket) {
+      throw new Error('Already connected.');
+    }
+    const config = parseConnectParams(params, this.userAgent);
+    try {
+      await this.open(config);
+      await this.hello(config);
+    } catch (error) {
+      this.close(error);
+      throw withReason(MSG_CONNECT_FAILED, error);
+    }
+    this.socket.unref();
+    return this;
+  }
+
+  open(config) {
+    return new Promise((resolve, reject) => {
+      const socket = config.use_ssl ?
+        tls.connect({ host: config.host, port: config.port,
+          rejectUnauthorized: false }) :
+        net.connect({ host: config.host, port: config.port });
+      socket.setNoDelay(true);
+      let received = Buffer.alloc(0);
+      const onError = (error) => {
+        socket.destroy();
+        reject(error);
+      };
+      const onHandshake = (data) => {
+        received = Buffer.concat([received, data]);
+        if (received.length < 4) {
+          return;
+        }
+        socket.off('data', onHandshake);
+        socket.off('error', onError);
+        socket.off('close', onError);
+        const major = received.readUInt8(3);
+        if (major !== 4 && major !== 1) {
+          onError(new Error('The server doesn\'t support the Bolt versions ' +
+            'of the client.'));
+          return;
+        }
+        this.attach(socket, major);
+        if (received.length > 4) {
+          this.onData(received.subarray(4));
+        }
+        resolve();
+      };
+      socket.once('error', onError);
+      socket.once('close', () => onError(new Error('Connection closed.')));
+      socket.on('data', onHandshake);
+      socket.once(config.use_ssl ? 'secureConnect' : 'connect', () => {
+        const handshake = Buffer.alloc(20);
+        handshake.writeUInt32BE(BOLT_MAGIC, 0);
+        PROPOSED_VERSIONS.forEach((version, index) =>
+          handshake.writeUInt32BE(version, 4 + index * 4));
+        socket.write(handshake);
+      });
+    });
+  }
+
+  attach(socket, major) {
+    this.socket = socket;
+    this.major = major;
+    socket.on('data', (data) => this.onData(data));
+    socket.on('error', (error) => this.close(error));
+    socket.on('close', () => this.close(new Error('Connection closed.')));
+  }
+
+  hello(config) {
+    const auth = config.username ?
+      { scheme: 'basic', principal: config.username,
+        credentials: config.password } :
+      { scheme: 'none' };
+    if (this.major === 1) {
+      return this.request(Message.HELLO, [config.client_name, auth]);
+    }
+    return this.request(Message.HELLO,
+      [{ user_agent: config.client_name, ...auth }]);
+  }
+
+  close(error) {
+    if (this.socket) {
+      const socket = this.socket;
+      this.socket = null;
+      socket.destroy();
+    }
+    const handlers = this.handlers;
+    this.handlers = [];
+    for (const handler of handlers) {
+      handler.failure(error);
+    }
+  }
+
+  pause() {
+    if (this.socket && !this.paused) {
+      this.paused = true;
+      this.socket.pause();
+    }
+  }
+
+  resume() {
+    if (this.socket && this.paused) {
+      this.paused = false;
+      this.socket.resume();
+    }
+  }
+
+  send(signature, fields, handler) {
+    this.socket.write(encodeMessage(signature, fields));
+    this.handlers.push(handler);
+  }
+
+  // Resolves with the SUCCESS metadata.
+  request(signature, fields) {
+    return new Promise((resolve, reject) => this.send(signature, fields, {
+      record: () => {},
+      success: resolve,
+      failure: reject,
+    }));
+  }
+
+  onData(data) {
+    for (const message of this.dechunker.push(data)) {
+      const handler = this.handlers[0];
+      const signature = message.length > 1 ? message.readUInt8(1) : null;
+      if (!handler) {
+        this.close(new Error('Unexpected message from the server.'));
+        return;
+      }
+      if (signature === Message.RECORD) {
+        handler.record(message);
+        continue;
+      }
+      this.handlers.shift();
+      let response;
+      try {
+        response = new Unpacker(message).unpack();
+      } catch (error) {
+        handler.failure(error);
+        this.close(error);
+        return;
+      }
+      switch (signature) {
+        case Message.SUCCESS:
+          handler.success(response.fields[0] || {});
+          break;
+        case Message.FAILURE:
+          // Everything sent after the failing request is IGNORED until the
+          // server is reset.
+          this.send(this.major === 1 ? Message.ACK_FAILURE : Message.RESET, [],
+            { record: () => {}, success: () => {}, failure: () => {} });
+          handler.failure(serverError(response.fields[0]));
+          break;
+        case Message.IGNORED:
+          handler.failure(
+            new Error('The request was ignored after a previous failure.'));
+          break;
+        default:
+          handler.failure(new Error('Unexpected message from the server.'));
+      }
+    }
+  }
+
+  // Runs the calls one after another, like the native command queue.
+  enqueue(run) {
+    if (!this.socket) {
+      throw new Error('Client is not connected.');
+    }
+    const queued = process.hrtime.bigint();
+    if (this.pending++ === 0) {
+      this.socket.ref();
+    }
+    const result = this.tail.then(async () => {
+      this.stats.queueWait.record(elapsedNanoseconds(queued));
+      ++this.stats.commands;
+      const start = process.hrtime.bigint();
+      try {
+        if (!this.socket) {
+          throw new Error('Client is not connected.');
+        }
+        return await run();
+      } catch (error) {
+        ++this.stats.errors;
+        throw error;
+      } finally {
+        this.stats.network.record(elapsedNanoseconds(start));
+        if (--this.pending === 0 && this.socket) {
+          this.socket.unref();
+        }
+      }
+    });
+    this.tail = result.catch(() => {});
+    return result;
+  }
+
+  // The records of FetchAll and ExecuteAndFetchAll. A time sliced conversion
+  // converts one slice per event loop turn and drops the converted messages.
+  async decodeAll(records, options) {
+    if (records === null || !(options.timeSlice > 0)) {
+      return records && this.decode(records, options);
+    }
+    const slice = BigInt(Math.floor(options.timeSlice * 1000));
+    const output = new Array(records.length);
+    let next = 0;
+    while (next < records.length) {
+      if (next > 0) {
+        await new Promise((resolve) => setImmediate(resolve));
+      }
+      const start = process.hrtime.bigint();
+      do {
+        output[next] = decodeRecord(records[next], options);
+        records[next++] = undefined;
+      } while (next < records.length &&
+        process.hrtime.bigint() - start < slice);
+      this.stats.conversion.record(elapsedNanoseconds(start));
+    }
+    return output;
+  }
+
+  decode(records, options) {
+    const start = process.hrtime.bigint();
+    const output = records.map((message) => decodeRecord(message, options));
+    this.stats.conversion.record(elapsedNanoseconds(start));
+    return output;
+  }
+
+  // The RUN message is encoded right away, like the native parameter
+  // snapshot, so later changes of the params don't affect the query.
+  encodeRun(query, params) {
+    if (query !== undefined && typeof query !== 'string') {
+      throw new Error('The first execute argument has to be string.');
+    }
+    if (params !== undefined && (params === null ||
+        typeof params !== 'object')) {
+      throw new Error(
+        'The second execute argument has to be an object containing query ' +
+        'parameters.');
+    }
+    const start = process.hrtime.bigint();
+    const packer = new ParamPacker();
+    packer.u8(0xb0 + (this.major === 1 ? 2 : 3));
+    packer.u8(Message.RUN);
+    packer.pack(query || '');
+    Packer.prototype.object.call(packer, params || {});
+    if (this.major !== 1) {
+      packer.pack({});
+    }
+    this.stats.encoding.record(elapsedNanoseconds(start));
+    ++this.stats.queries;
+    return packer.take();
+  }
+
+  // Sends RUN followed by PULL (or DISCARD) of the whole result and resolves
+  // once the RUN succeeded. The stream receives the records.
+  async run(message, stream, signature = Message.PULL) {
+    await this.finishStream();
+    const run = new Promise((resolve, reject) => {
+      this.socket.write(chunk(message));
+      this.handlers.push({ record: () => {}, success: resolve,
+        failure: reject });
+    });
+    this.send(signature, this.major === 1 ? [] : [{ n: -1n }], stream);
+    try {
+      await run;
+    } catch (error) {
+      throw withReason(MSG_EXECUTE_FAIL, error);
+    }
+  }
+
+  async finishStream() {
+    if (this.stream) {
+      const stream = this.stream;
+      this.stream = null;
+      await stream.discard();
+    }
+  }
+
+  Execute(query, params) {
+    const message = this.encodeRun(query, params);
+    return this.enqueue(async () => {
+      const stream = new ResultStream(this);
+      await this.run(message, stream);
+      this.stream = stream;
+      return null;
+    });
+  }
+
+  ExecuteAndFetchAll(query, params, options) {
+    const message = this.encodeRun(query, params);
+    const decodeOptions = parseDecodeOptions(options, this.options);
+    // The conversion doesn't hold up the following calls.
+    return this.enqueue(async () => {
+      const stream = new ResultStream(this);
+      await this.run(message, stream);
+      try {
+        return await stream.all();
+      } catch (error) {
+        throw withReason(MSG_FETCH_ALL_FAIL, error);
+      }
+    }).then((records) => this.decodeAll(records, decodeOptions));
+  }
+
+  ExecuteAndDiscardAll(query, params) {
+    const message = this.encodeRun(query, params);
+    return this.enqueue(async () => {
+      const stream = new ResultStream(this);
+      stream.discarding = true;
+      await this.run(message, stream, Message.DISCARD);
+      try {
+        await stream.discard();
+      } catch (error) {
+        throw withReason(MSG_DISCARD_ALL_FAIL, error);
+      }
+      if (stream.error) {
+        throw withReason(MSG_DISCARD_ALL_FAIL, stream.error);
+      }
+      return null;
+    });
+  }
+
+  // Runs every statement followed by FetchAll as a single call, see the
+  // native ExecuteManyCommand.
+  ExecuteMany(statements, transactional, options) {
+    if (!Array.isArray(statements) || !statements.every(isStatement)) {
+      throw new Error(MSG_WRONG_STATEMENTS_ARG);
+    }
+    const messages = statements.map((statement) =>
+      this.encodeRun(statement.query, statement.params));
+    const decodeOptions = { ...parseDecodeOptions(options, this.options),
+      timeSlice: 0 };
+    return this.enqueue(async () => {
+      await this.finishStream();
+      if (transactional && this.major !== 1) {
+        return await this.pipelineTransaction(messages);
+      }
+      if (transactional) {
+        await this.transactionRequest(Message.BEGIN, 'BEGIN',
+          'Fail to BEGIN transaction.');
+      }
+      const results = [];
+      let failed = false;
+      for (const message of messages) {
+        if (failed && transactional) {
+          results.push({ error: new Error(MSG_NOT_EXECUTED) });
+          continue;
+        }
+        try {
+          const stream = new ResultStream(this);
+          await this.run(message, stream);
+          try {
+            results.push({ records: await stream.all() });
+          } catch (error) {
+            throw withReason(MSG_FETCH_ALL_FAIL, error);
+          }
+        } catch (error) {
+          failed = true;
+          results.push({ error: error });
+        }
+      }
+      if (transactional && failed) {
+        // The server may have aborted the transaction already.
+        await this.transactionRequest(Message.ROLLBACK, 'ROLLBACK',
+          'Fail to ROLLBACK transaction.').catch(() => {});
+      } else if (transactional) {
+        await this.transactionRequest(Message.COMMIT, 'COMMIT',
+          'Fail to COMMIT transaction.');
+      }
+      return results;
+    }).then((results) => results.map((result) => result.records ?
+      { records: this.decode(result.records, decodeOptions) } : result));
+  }
+
+  // Writes BEGIN, RUN and PULL of every statement and COMMIT at once, so the
+  // whole transaction takes a single round trip. After a failure the server
+  // ignores the rest, and the RESET sent by onData rolls the transaction back.
+  async pipelineTransaction(messages) {
+    const settled = (promise) => promise.then(
+      (value) => ({ value: value }), (error) => ({ error: error }));
+    const begin = settled(this.request(Message.BEGIN, [{}]));
+    const statements = messages.map((message) => {
+      const stream = new ResultStream(this);
+      const run = settled(new Promise((resolve, reject) => {
+        this.socket.write(chunk(message));
+        this.handlers.push({ record: () => {}, success: resolve,
+          failure: reject });
+      }));
+      this.send(Message.PULL, [{ n: -1n }], stream);
+      return { run: run, stream: stream };
+    });
+    const commit = settled(this.request(Message.COMMIT, []));
+    const begun = await begin;
+    const results = [];
+    let failed = begun.error;
+    for (const { run, stream } of statements) {
+      const { error } = await run;
+      if (failed || error) {
+        await stream.discard();
+        results.push({ error: failed ? new Error(MSG_NOT_EXECUTED) :
+          withReason(MSG_EXECUTE_FAIL, error) });
+        failed = failed || error;
+        continue;
+      }
+      try {
+        results.push({ records: await stream.all() });
+      } catch (error) {
+        results.push({ error: withReason(MSG_FETCH_ALL_FAIL, error) });
+        failed = error;
+      }
+    }
+    const committed = await commit;
+    if (begun.error) {
+      throw withReason('Fail to BEGIN transaction.', begun.error);
+    }
+    if (!failed && committed.error) {
+      throw withReason('Fail to COMMIT transaction.', committed.error);
+    }
+    return results;
+  }
+
+  FetchAll(options) {
+    const decodeOptions = parseDecodeOptions(options, this.options);
+    return this.enqueue(async () => {
+      const stream = this.stream;
+      if (!stream) {
+        return null;
+      }
+      this.stream = null;
+      try {
+        return await stream.all();
+      } catch (error) {
+        throw withReason(MSG_FETCH_ALL_FAIL, error);
+      }
+    }).then((records) => this.decodeAll(records, decodeOptions));
+  }
+
+  DiscardAll() {
+    return this.enqueue(async () => {
+      const stream = this.stream;
+      await this.finishStream();
+      if (stream && stream.error) {
+        throw withReason(MSG_DISCARD_ALL_FAIL, stream.error);
+      }
+      return null;
+    });
+  }
+
+  FetchOne(options) {
+    const decodeOptions = parseDecodeOptions(options, this.options);
+    return this.enqueue(async () => {
+      const stream = this.stream;
+      if (!stream) {
+        return null;
+      }
+      let message;
+      try {
+        message = await stream.next();
+      } catch (error) {
+        this.stream = null;
+        throw withReason(MSG_FETCH_ONE_FAIL, error);
+      }
+      if (message === null) {
+        this.stream = null;
+        return null;
+      }
+      return this.decode([message], decodeOptions)[0];
+    });
+  }
+
+  FetchBatch(batchSize, options) {
+    if (typeof batchSize !== 'number') {
+      throw new Error(
+        'FetchBatch requires the batch size as a number argument.');
+    }
+    if (!(batchSize >= 1)) {
+      throw new Error('The batch size has to be a positive number.');
+    }
+    const decodeOptions = parseDecodeOptions(options, this.options);
+    return this.enqueue(async () => {
+      const stream = this.stream;
+      const records = [];
+      while (stream && records.length < batchSize) {
+        let message;
+        try {
+          message = await stream.next();
+        } catch (error) {
+          this.stream = null;
+          throw withReason(MSG_FETCH_BATCH_FAIL, error);
+        }
+        if (message === null) {
+          this.stream = null;
+          break;
+        }
+        records.push(message);
+      }
+      return this.decode(records, decodeOptions);
+    });
+  }
+
+  FetchColumns() {
+    throw new Error('FetchColumns isn\'t supported by the event loop engine.');
+  }
+
+  FetchSnapshot() {
+    throw new Error('FetchSnapshot isn\'t supported by the event loop engine.');
+  }
+
+  Prepare(query) {
+    if (typeof query !== 'string') {
+      throw new Error('Prepare requires the query as a string argument.');
+    }
+    return new PreparedQuery(this, query);
+  }
+
+  // v1 controls transactions with queries, v4 with messages.
+  async transactionRequest(signature, query, failMessage) {
+    try {
+      if (this.major === 1) {
+        const stream = new ResultStream(this);
+        const packer = new Packer();
+        packer.pack(new Structure(Message.RUN, [query, {}]));
+        await this.run(packer.take(), stream);
+        await stream.discard();
+        if (stream.error) {
+          throw stream.error;
+        }
+      } else {
+        await this.request(signature, signature === Message.BEGIN ?
+          [{}] : []);
+      }
+    } catch (error) {
+      throw withReason(failMessage, error);
+    }
+  }
+
+  transaction(signature, query, failMessage) {
+    return this.enqueue(async () => {
+      await this.finishStream();
+      await this.transactionRequest(signature, query, failMessage);
+      return null;
+    });
+  }
+
+  Begin() {
+    return this.transaction(Message.BEGIN, 'BEGIN',
+      'Fail to BEGIN transaction.');
+  }
+
+  Commit() {
+    return this.transaction(Message.COMMIT, 'COMMIT',
+      'Fail to COMMIT transaction.');
+  }
+
+  Rollback() {
+    return this.transaction(Message.ROLLBACK, 'ROLLBACK',
+      'Fail to ROLLBACK transaction.');
+  }
+
+  SetOptions(options) {
+    this.options = parseDecodeOptions(options, this.options);
+  }
+
+  Stats() {
+    return this.stats.toJSON();
+  }
+
+  ResetStats() {
+    this.stats.reset();
+  }
+
+  /** Says GOODBYE and closes the socket. Pending calls are rejected. */
+  Close() {
+    if (!this.socket) {
+      return;
+    }
+    this.socket.end(encodeMessage(Message.GOODBYE, []));
+    this.close(new Error('Connection closed.'));
+  }
+}
+
+module.exports = {
+  BoltClient,
+};
@@ -0,0 +1,396 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// PackStream codec shared by the event loop Bolt engine (lib/bolt.js) and the
+// Bolt stand-in server of the tests. Integers are BigInts, Numbers are always
+// encoded as floats, which matches the native client.
+
+class Structure {
+  constructor(signature, fields) {
+    this.signature = signature;
+    this.fields = fields;
+  }
+}
+
+const Signature = {
+  NODE: 0x4e,
+  RELATIONSHIP: 0x52,
+  UNBOUND_RELATIONSHIP: 0x72,
+  PATH: 0x50,
+  DATE: 0x44,
+  LOCAL_TIME: 0x74,
+  LOCAL_DATE_TIME: 0x64,
+  DURATION: 0x45,
+};
+
+const INT8_MIN = -128n;
+const INT16_MIN = -32768n;
+const INT16_MAX = 32767n;
+const INT32_MIN = -2147483648n;
+const INT32_MAX = 2147483647n;
+
+class Packer {
+  constructor() {
+    this.buffer = Buffer.alloc(1024);
+    this.size = 0;
+  }
+
+  reserve(size) {
+    if (this.size + size <= this.buffer.length) {
+      return;
+    }
+    const buffer = Buffer.alloc(Math.max(this.buffer.length * 2,
+      this.size + size));
+    this.buffer.copy(buffer, 0, 0, this.size);
+    this.buffer = buffer;
+  }
+
+  u8(value) {
+    this.reserve(1);
+    this.buffer.writeUInt8(value, this.size);
+    this.size += 1;
+  }
+
+  u16(value) {
+    this.reserve(2);
+    this.buffer.writeUInt16BE(value, this.size);
+    this.size += 2;
+  }
+
+  u32(value) {
+    this.reserve(4);
+    this.buffer.writeUInt32BE(value, this.size);
+    this.size += 4;
+  }
+
+  header(size, tiny, markers) {
+    if (size < 16 && tiny !== undefined) {
+      this.u8(tiny + size);
+    } else if (size < 0x100 && markers[0] !== undefined) {
+      this.u8(markers[0]);
+      this.u8(size);
+    } else if (size < 0x10000) {
+      this.u8(markers[1]);
+      this.u16(size);
+    } else {
+      this.u8(markers[2]);
+      this.u32(size);
+    }
+  }
+
+  integer(value) {
+    if (value >= -16n && value <= 127n) {
+      this.u8(Number(BigInt.asUintN(8, value)));
+    } else if (value >= INT8_MIN && value < -16n) {
+      this.u8(0xc8);
+      this.reserve(1);
+      this.buffer.writeInt8(Number(value), this.size);
+      this.size += 1;
+    } else if (value >= INT16_MIN && value <= INT16_MAX) {
+      this.u8(0xc9);
+      this.reserve(2);
+      this.buffer.writeInt16BE(Number(value), this.size);
+      this.size += 2;
+    } else if (value >= INT32_MIN && value <= INT32_MAX) {
+      this.u8(0xca);
+      this.reserve(4);
+      this.buffer.writeInt32BE(Number(value), this.size);
+      this.size += 4;
+    } else {
+      this.u8(0xcb);
+      this.reserve(8);
+      this.buffer.writeBigInt64BE(value, this.size);
+      this.size += 8;
+    }
+  }
+
+  pack(value) {
+    if (value === null || value === undefined) {
+      this.u8(0xc0);
+    } else if (value === true) {
+      this.u8(0xc3);
+    } else if (value === false) {
+      this.u8(0xc2);
+    } else if (typeof value === 'bigint') {
+      this.integer(value);
+    } else if (typeof value === 'number') {
+      this.u8(0xc1);
+      this.reserve(8);
+      this.buffer.writeDoubleBE(value, this.size);
+      this.size += 8;
+    } else if (typeof value === 'string') {
+      const bytes = Buffer.from(value, 'utf8');
+      this.header(bytes.length, 0x80, [0xd0, 0xd1, 0xd2]);
+      this.reserve(bytes.length);
+      bytes.copy(this.buffer, this.size);
+      this.size += bytes.length;
+    } else if (Array.isArray(value)) {
+      this.header(value.length, 0x90, [0xd4, 0xd5, 0xd6]);
+      for (const item of value) {
+        this.pack(item);
+      }
+    } else if (ArrayBuffer.isView(value) && !(value instanceof DataView)) {
+      this.typedArray(value);
+    } else if (value instanceof Structure) {
+      this.u8(0xb0 + value.fields.length);
+      this.u8(value.signature);
+      for (const field of value.fields) {
+        this.pack(field);
+      }
+    } else if (typeof value === 'object') {
+      this.object(value);
+    } else {
+      throw new Error(`Value ${value} can't be packed.`);
+    }
+  }
+
+  // Float arrays become lists of floats, the others lists of integers.
+  typedArray(value) {
+    this.header(value.length, 0x90, [0xd4, 0xd5, 0xd6]);
+    if (value instanceof Float64Array || value instanceof Float32Array) {
+      this.reserve(value.length * 9);
+      for (const item of value) {
+        this.buffer.writeUInt8(0xc1, this.size);
+        this.buffer.writeDoubleBE(item, this.size + 1);
+        this.size += 9;
+      }
+      return;
+    }
+    for (const item of value) {
+      this.integer(BigInt(item));
+    }
+  }
+
+  // Plain objects are maps, subclasses map other objects (e.g. temporal
+  // types) to Structures.
+  object(value) {
+    const entries = Object.entries(value);
+    this.header(entries.length, 0xa0, [0xd8, 0xd9, 0xda]);
+    for (const [key, item] of entries) {
+      this.pack(key);
+      this.pack(item);
+    }
+  }
+
+  take() {
+    const output = this.buffer.subarray(0, this.size);
+    this.buffer = Buffer.alloc(1024);
+    this.size = 0;
+    return output;
+  }
+}
+
+// Subclasses override integer, list and structure to map the decoded values.
+class Unpacker {
+  constructor(buffer) {
+    this.buffer = buffer;
+    this.offset = 0;
+  }
+
+  integer(value) {
+    return value;
+  }
+
+  list(size) {
+    const list = new Array(size);
+    for (let index = 0; index < size; ++index) {
+      list[index] = this.unpack();
+    }
+    return list;
+  }
+
+  structure(signature, fields) {
+    return new Structure(signature, fields);
+  }
+
+  u8() {
+    return this.buffer.readUInt8(this.offset++);
+  }
+
+  size(marker, tiny, markers) {
+    if (tiny !== undefined && (marker & 0xf0) === tiny) {
+      return marker & 0x0f;
+    }
+    const width = markers.indexOf(marker);
+    const offset = this.offset;
+    this.offset += 1 << width;
+    return [
+      () => this.buffer.readUInt8(offset),
+      () => this.buffer.readUInt16BE(offset),
+      () => this.buffer.readUInt32BE(offset),
+    ][width]();
+  }
+
+  string(size) {
+    const value = this.buffer.toString('utf8', this.offset,
+      this.offset + size);
+    this.offset += size;
+    return value;
+  }
+
+  /**
+    * @param {number} marker - The already consumed marker byte.
+    * @return {BigInt|undefined} The integer, or undefined if the marker
+    * doesn't start an integer.
+    */
+  readInteger(marker) {
+    if (marker <= 0x7f) {
+      return BigInt(marker);
+    }
+    if (marker >= 0xf0) {
+      return BigInt(marker - 0x100);
+    }
+    const offset = this.offset;
+    switch (marker) {
+      case 0xc8:
+        this.offset += 1;
+        return BigInt(this.buffer.readInt8(offset));
+      case 0xc9:
+        this.offset += 2;
+        return BigInt(this.buffer.readInt16BE(offset));
+      case 0xca:
+        this.offset += 4;
+        return BigInt(this.buffer.readInt32BE(offset));
+      case 0xcb:
+        this.offset += 8;
+        return this.buffer.readBigInt64BE(offset);
+      default:
+        return undefined;
+    }
+  }
+
+  unpack() {
+    const marker = this.u8();
+    const integer = this.readInteger(marker);
+    if (integer !== undefined) {
+      return this.integer(integer);
+    }
+    const high = marker & 0xf0;
+    if (high === 0x80 || (marker >= 0xd0 && marker <= 0xd2)) {
+      return this.string(this.size(marker, 0x80, [0xd0, 0xd1, 0xd2]));
+    }
+    if (high === 0x90 || (marker >= 0xd4 && marker <= 0xd6)) {
+      return this.list(this.size(marker, 0x90, [0xd4, 0xd5, 0xd6]));
+    }
+    if (high === 0xa0 || (marker >= 0xd8 && marker <= 0xda)) {
+      const size = this.size(marker, 0xa0, [0xd8, 0xd9, 0xda]);
+      const map = {};
+      for (let index = 0; index < size; ++index) {
+        const key = this.unpack();
+        // A plain assignment would set the prototype.
+        Object.defineProperty(map, key, {
+          value: this.unpack(),
+          writable: true,
+          enumerable: true,
+          configurable: true,
+        });
+      }
+      return map;
+    }
+    if (high === 0xb0) {
+      const signature = this.u8();
+      const fields = new Array(marker & 0x0f);
+      for (let index = 0; index < fields.length; ++index) {
+        fields[index] = this.unpack();
+      }
+      return this.structure(signature, fields);
+    }
+    const offset = this.offset;
+    switch (marker) {
+      case 0xc0:
+        return null;
+      case 0xc1:
+        this.offset += 8;
+        return this.buffer.readDoubleBE(offset);
+      case 0xc2:
+        return false;
+      case 0xc3:
+        return true;
+      default:
+        throw new Error(`Unknown PackStream marker 0x${marker.toString(16)}.`);
+    }
+  }
+}
+
+// Bolt messages are split into chunks of at most 0xffff bytes, each prefixed
+// by its u16 size, and terminated by an empty chunk.
+function chunk(message) {
+  const chunks = [];
+  for (let offset = 0; offset < message.length; offset += 0xffff) {
+    const part = message.subarray(offset, offset + 0xffff);
+    const header = Buffer.alloc(2);
+    header.writeUInt16BE(part.length);
+    chunks.push(header, part);
+  }
+  chunks.push(Buffer.alloc(2));
+  return Buffer.concat(chunks);
+}
+
+// Collects the chunks received from a socket into whole messages.
+class Dechunker {
+  constructor() {
+    this.pending = Buffer.alloc(0);
+    this.parts = [];
+  }
+
+  /**
+    * @param {Buffer} data - The received bytes.
+    * @return {Array<Buffer>} The completed messages.
+    */
+  push(data) {
+    this.pending = Buffer.concat([this.pending, data]);
+    const messages = [];
+    for (;;) {
+      if (this.pending.length < 2) {
+        break;
+      }
+      const size = this.pending.readUInt16BE(0);
+      if (this.pending.length < 2 + size) {
+        break;
+      }
+      if (size === 0) {
+        // Without parts it's a NOOP (a Bolt 4.1 keep-alive), not a message.
+        if (this.parts.length > 0) {
+          messages.push(Buffer.concat(this.parts));
+          this.parts = [];
+        }
+      } else {
+        this.parts.push(this.pending.subarray(2, 2 + size));
+      }
+      this.pending = this.pending.subarray(2 + size);
+    }
+    return messages;
+  }
+}
+
+function encodeMessage(signature, fields) {
+  const packer = new Packer();
+  packer.pack(new Structure(signature, fields));
+  return chunk(packer.take());
+}
+
+function decodeMessage(message) {
+  return new Unpacker(message).unpack();
+}
+
+module.exports = {
+  Dechunker,
+  Packer,
+  Signature,
+  Structure,
+  Unpacker,
+  chunk,
+  decodeMessage,
+  encodeMessage,
+};
@@ -0,0 +1,45 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+export class ResultSnapshot {
+    /**
+      * @param {ArrayBuffer} buffer - The snapshot returned by FetchSnapshot.
+      * @param {Object} options - `{ integers }`, the same as
+      * Connection.SetOptions.
+      */
+    constructor(buffer: ArrayBuffer, options?: any);
+    buffer: ArrayBuffer;
+    rowCount: number;
+    /**
+      * The number of cells in the row.
+      * @param {number} row - The row index.
+      */
+    cellCount(row: number): number;
+    /**
+      * Decode a single cell.
+      * @param {number} row - The row index.
+      * @param {number} cell - The cell index within the row.
+      */
+    cell(row: number, cell: number): any;
+    /**
+      * Decode all cells of the row.
+      * @param {number} row - The row index.
+      */
+    row(row: number): any[];
+    /**
+      * Decode all rows, the result is the same as the one of FetchAll.
+      */
+    toArray(): any[][];
+    [Symbol.iterator](): Generator<any[], void, unknown>;
+}
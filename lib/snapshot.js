@@ -0,0 +1,322 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Decoder of the flat result snapshot created by src/snapshot.cpp. The layout
+// is documented there and both files have to be kept in sync.
+
+const SNAPSHOT_MAGIC = 0x3153474d;
+const HEADER_SIZE = 16;
+
+const Tag = {
+  NULL: 0,
+  FALSE: 1,
+  TRUE: 2,
+  INTEGER: 3,
+  FLOAT: 4,
+  STRING: 5,
+  LIST: 6,
+  MAP: 7,
+  NODE: 8,
+  RELATIONSHIP: 9,
+  UNBOUND_RELATIONSHIP: 10,
+  PATH: 11,
+  DATE: 12,
+  LOCAL_TIME: 13,
+  LOCAL_DATE_TIME: 14,
+  DURATION: 15,
+};
+
+const TWO_POW_32 = 4294967296;
+// The high word range of the integers which are safe as a Number.
+const MIN_SAFE_HIGH = -0x200000;
+const MAX_SAFE_HIGH = 0x1fffff;
+
+const textDecoder = new TextDecoder();
+
+// ResultSnapshot reads rows and cells of a fetched result on demand. Only
+// the accessed cells are converted and every string is decoded at most once.
+// The buffer can be transferred to a worker_thread and wrapped there again.
+class ResultSnapshot {
+  /**
+    * @param {ArrayBuffer} buffer - The snapshot returned by FetchSnapshot.
+    * @param {Object} options - `{ integers }`, the same as
+    * Connection.SetOptions.
+    */
+  constructor(buffer, options = {}) {
+    this.buffer = buffer;
+    this.view = new DataView(buffer);
+    if (
+      buffer.byteLength < HEADER_SIZE ||
+      this.view.getUint32(0, true) !== SNAPSHOT_MAGIC
+    ) {
+      throw new Error('The buffer is not a result snapshot.');
+    }
+    this.rowCount = this.view.getUint32(4, true);
+    const stringCount = this.view.getUint32(8, true);
+    this.stringTable = this.view.getUint32(12, true);
+    this.stringBytes = this.stringTable + (stringCount + 1) * 4;
+    this.strings = new Array(stringCount);
+    this.integers = options.integers || 'bigint';
+    this.offset = 0;
+  }
+
+  /**
+    * The number of cells in the row.
+    * @param {number} row - The row index.
+    */
+  cellCount(row) {
+    return this.view.getUint32(this.rowOffset(row), true);
+  }
+
+  /**
+    * Decode a single cell.
+    * @param {number} row - The row index.
+    * @param {number} cell - The cell index within the row.
+    */
+  cell(row, cell) {
+    const rowOffset = this.rowOffset(row);
+    if (cell >= this.view.getUint32(rowOffset, true)) {
+      throw new RangeError('The cell index is out of range.');
+    }
+    this.offset = this.view.getUint32(rowOffset + 4 + cell * 4, true);
+    return this.readValue();
+  }
+
+  /**
+    * Decode all cells of the row.
+    * @param {number} row - The row index.
+    */
+  row(row) {
+    const rowOffset = this.rowOffset(row);
+    const cellCount = this.view.getUint32(rowOffset, true);
+    const output = new Array(cellCount);
+    this.offset = rowOffset + 4 + cellCount * 4;
+    for (let cell = 0; cell < cellCount; ++cell) {
+      output[cell] = this.readValue();
+    }
+    return output;
+  }
+
+  /**
+    * Decode all rows, the result is the same as the one of FetchAll.
+    */
+  toArray() {
+    const output = new Array(this.rowCount);
+    for (let row = 0; row < this.rowCount; ++row) {
+      output[row] = this.row(row);
+    }
+    return output;
+  }
+
+  *[Symbol.iterator]() {
+    for (let row = 0; row < this.rowCount; ++row) {
+      yield this.row(row);
+    }
+  }
+
+  rowOffset(row) {
+    if (row < 0 || row >= this.rowCount) {
+      throw new RangeError('The row index is out of range.');
+    }
+    return this.view.getUint32(HEADER_SIZE + row * 4, true);
+  }
+
+  readUint8() {
+    const value = this.view.getUint8(this.offset);
+    this.offset += 1;
+    return value;
+  }
+
+  readUint32() {
+    const value = this.view.getUint32(this.offset, true);
+    this.offset += 4;
+    return value;
+  }
+
+  readInteger() {
+    const offset = this.offset;
+    this.offset += 8;
+    if (this.integers === 'bigint') {
+      return this.view.getBigInt64(offset, true);
+    }
+    const low = this.view.getUint32(offset, true);
+    const high = this.view.getInt32(offset + 4, true);
+    if (
+      this.integers === 'auto' &&
+      (high < MIN_SAFE_HIGH ||
+        high > MAX_SAFE_HIGH ||
+        (high === MIN_SAFE_HIGH && low === 0))
+    ) {
+      return this.view.getBigInt64(offset, true);
+    }
+    return high * TWO_POW_32 + low;
+  }
+
+  readString() {
+    const index = this.readUint32();
+    let value = this.strings[index];
+    if (value === undefined) {
+      const start = this.view.getUint32(this.stringTable + index * 4, true);
+      const end = this.view.getUint32(this.stringTable + index * 4 + 4, true);
+      value = textDecoder.decode(
+        new Uint8Array(this.buffer, this.stringBytes + start, end - start),
+      );
+      this.strings[index] = value;
+    }
+    return value;
+  }
+
+  readMap() {
+    const size = this.readUint32();
+    const output = {};
+    for (let index = 0; index < size; ++index) {
+      const key = this.readString();
+      output[key] = this.readValue();
+    }
+    return output;
+  }
+
+  readNode() {
+    const id = this.readInteger();
+    const labelCount = this.readUint32();
+    const labels = new Array(labelCount);
+    for (let index = 0; index < labelCount; ++index) {
+      labels[index] = this.readString();
+    }
+    return {
+      objectType: 'node',
+      id: id,
+      labels: labels,
+      properties: this.readMap(),
+    };
+  }
+
+  readUnboundRelationship() {
+    return {
+      objectType: 'relationship',
+      id: this.readInteger(),
+      startNodeId: -1,
+      endNodeId: -1,
+      edgeType: this.readString(),
+      properties: this.readMap(),
+    };
+  }
+
+  readPath() {
+    const length = this.readUint32();
+    const nodes = new Array(length + 1);
+    for (let index = 0; index <= length; ++index) {
+      nodes[index] = this.readNode();
+    }
+    const relationships = new Array(length);
+    for (let index = 0; index < length; ++index) {
+      const reversed = this.readUint8() !== 0;
+      const relationship = this.readUnboundRelationship();
+      const previous = nodes[index].id;
+      const current = nodes[index + 1].id;
+      relationship.startNodeId = reversed ? current : previous;
+      relationship.endNodeId = reversed ? previous : current;
+      relationships[index] = relationship;
+    }
+    return {
+      objectType: 'path',
+      nodes: nodes,
+      relationships: relationships,
+    };
+  }
+
+  readValue() {
+    const tag = this.readUint8();
+    switch (tag) {
+      case Tag.NULL:
+        return null;
+      case Tag.FALSE:
+        return false;
+      case Tag.TRUE:
+        return true;
+      case Tag.INTEGER:
+        return this.readInteger();
+      case Tag.FLOAT: {
+        const value = this.view.getFloat64(this.offset, true);
+        this.offset += 8;
+        return value;
+      }
+      case Tag.STRING:
+        return this.readString();
+      case Tag.LIST: {
+        const size = this.readUint32();
+        const output = new Array(size);
+        for (let index = 0; index < size; ++index) {
+          output[index] = this.readValue();
+        }
+        return output;
+      }
+      case Tag.MAP:
+        return this.readMap();
+      case Tag.NODE:
+        return this.readNode();
+      case Tag.RELATIONSHIP:
+        return {
+          objectType: 'relationship',
+          id: this.readInteger(),
+          startNodeId: this.readInteger(),
+          endNodeId: this.readInteger(),
+          edgeType: this.readString(),
+          properties: this.readMap(),
+        };
+      case Tag.UNBOUND_RELATIONSHIP:
+        return this.readUnboundRelationship();
+      case Tag.PATH:
+        return this.readPath();
+      case Tag.DATE: {
+        const days = this.view.getBigInt64(this.offset, true);
+        return {
+          objectType: 'date',
+          days: this.readInteger(),
+          date: new Date(Number(days) * 24 * 60 * 60 * 1000),
+        };
+      }
+      case Tag.LOCAL_TIME:
+        return {
+          objectType: 'local_time',
+          nanoseconds: this.readInteger(),
+        };
+      case Tag.LOCAL_DATE_TIME: {
+        const seconds = this.view.getBigInt64(this.offset, true);
+        const nanoseconds = this.view.getBigInt64(this.offset + 8, true);
+        // The same precision as the native conversion.
+        const milliseconds = seconds * 1000n + nanoseconds / 10000000n;
+        return {
+          objectType: 'local_date_time',
+          seconds: this.readInteger(),
+          nanoseconds: this.readInteger(),
+          date: new Date(Number(milliseconds)),
+        };
+      }
+      case Tag.DURATION:
+        return {
+          objectType: 'duration',
+          days: this.readInteger(),
+          seconds: this.readInteger(),
+          nanoseconds: this.readInteger(),
+        };
+      default:
+        throw new Error(`Unknown snapshot value tag ${tag}.`);
+    }
+  }
+}
+
+module.exports = {
+  ResultSnapshot,
+};
@@ -0,0 +1,152 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Connection stats of the event loop engine, in the same shape as the native
+// ones (src/stats.cpp) so that Connection.Stats doesn't depend on the engine.
+
+const SUB_BUCKET_BITS = 4;
+const SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+const MAX_EXPONENT = 40;
+const BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+const PHASES = [
+  'queueWait',
+  'threadpoolWait',
+  'network',
+  'encoding',
+  'conversion',
+];
+const COUNTERS = ['queries', 'commands', 'errors', 'rows', 'bytes'];
+
+// Log-linear histogram of durations in nanoseconds, the same bucketing as
+// the native Histogram.
+class Histogram {
+  constructor() {
+    this.reset();
+  }
+
+  static bucketIndex(value) {
+    if (value < SUB_BUCKETS) {
+      return value;
+    }
+    let exponent = Math.floor(Math.log2(value));
+    // log2 may round up just below a power of two.
+    if (2 ** exponent > value) {
+      --exponent;
+    }
+    if (exponent > MAX_EXPONENT) {
+      return BUCKET_COUNT - 1;
+    }
+    const shift = 2 ** (exponent - SUB_BUCKET_BITS);
+    const subBucket = Math.floor(value / shift) % SUB_BUCKETS;
+    return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + subBucket;
+  }
+
+  // The highest value which falls into the bucket.
+  static bucketValue(index) {
+    if (index < SUB_BUCKETS) {
+      return index;
+    }
+    const shift = 2 ** (Math.floor(index / SUB_BUCKETS) - 1);
+    return (SUB_BUCKETS + (index % SUB_BUCKETS)) * shift + shift - 1;
+  }
+
+  record(nanoseconds) {
+    const value = Math.max(0, Math.round(nanoseconds));
+    ++this.counts[Histogram.bucketIndex(value)];
+    ++this.count;
+    this.sum += value;
+    this.min = Math.min(this.min, value);
+    this.max = Math.max(this.max, value);
+  }
+
+  reset() {
+    this.counts = new Float64Array(BUCKET_COUNT);
+    this.count = 0;
+    this.sum = 0;
+    this.min = Infinity;
+    this.max = 0;
+  }
+
+  percentile(fraction) {
+    const rank = Math.max(1, Math.ceil(fraction * this.count));
+    let seen = 0;
+    for (let index = 0; index < BUCKET_COUNT; ++index) {
+      seen += this.counts[index];
+      if (seen >= rank) {
+        return Math.min(Math.max(Histogram.bucketValue(index), this.min),
+          this.max);
+      }
+    }
+    return this.max;
+  }
+
+  // In milliseconds, see Connection.Stats.
+  toJSON() {
+    if (this.count === 0) {
+      return { count: 0, min: 0, mean: 0, p50: 0, p90: 0, p99: 0, p999: 0,
+        max: 0 };
+    }
+    return {
+      count: this.count,
+      min: this.min / 1e6,
+      mean: this.sum / this.count / 1e6,
+      p50: this.percentile(0.5) / 1e6,
+      p90: this.percentile(0.9) / 1e6,
+      p99: this.percentile(0.99) / 1e6,
+      p999: this.percentile(0.999) / 1e6,
+      max: this.max / 1e6,
+    };
+  }
+}
+
+class ClientStats {
+  constructor() {
+    for (const phase of PHASES) {
+      this[phase] = new Histogram();
+    }
+    this.reset();
+  }
+
+  reset() {
+    for (const phase of PHASES) {
+      this[phase].reset();
+    }
+    for (const counter of COUNTERS) {
+      this[counter] = 0;
+    }
+  }
+
+  toJSON() {
+    const output = {};
+    for (const counter of COUNTERS) {
+      output[counter] = this[counter];
+    }
+    for (const phase of PHASES) {
+      output[phase] = this[phase].toJSON();
+    }
+    return output;
+  }
+}
+
+// Nanoseconds since start, a process.hrtime.bigint() value.
+function elapsedNanoseconds(start) {
+  return Number(process.hrtime.bigint() - start);
+}
+
+module.exports = {
+  ClientStats,
+  Histogram,
+  elapsedNanoseconds,
+};
@@ -15,9 +15,17 @@
 #include <napi.h>
 
 #include "client.hpp"
+#include "graph.hpp"
+#include "pool.hpp"
+#include "statement.hpp"
 
 Napi::Object InitAll(Napi::Env env, Napi::Object exports) {
-  return nodemg::Client::Init(env, exports);
+  nodemg::Client::Init(env, exports);
+  nodemg::Node::Init(env, exports);
+  nodemg::Relationship::Init(env, exports);
+  nodemg::Path::Init(env, exports);
+  nodemg::Statement::Init(env, exports);
+  return nodemg::Pool::Init(env, exports);
 }
 
 NODE_API_MODULE(addon, InitAll)
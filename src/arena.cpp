@@ -0,0 +1,40 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "arena.hpp"
+
+namespace nodemg {
+
+std::vector<uint8_t> ArenaPool::Acquire() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (arenas_.empty()) {
+    return {};
+  }
+  auto arena = std::move(arenas_.back());
+  arenas_.pop_back();
+  return arena;
+}
+
+void ArenaPool::Release(std::vector<uint8_t> buffer) {
+  if (buffer.capacity() == 0 || buffer.capacity() > kMaxArenaCapacity) {
+    return;
+  }
+  buffer.clear();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (arenas_.size() < kMaxArenas) {
+    arenas_.push_back(std::move(buffer));
+  }
+}
+
+}  // namespace nodemg
@@ -0,0 +1,45 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace nodemg {
+
+/// Flat buffers (the parameter and result snapshots) recycled across the
+/// queries of one client, so that a steady stream of queries doesn't
+/// allocate a new buffer for each of them. Acquired on the main thread and
+/// released on either thread.
+class ArenaPool {
+ public:
+  /// An empty buffer, with the capacity of a previously released one if
+  /// there is any.
+  std::vector<uint8_t> Acquire();
+  /// Keeps the buffer for the next Acquire. Buffers above the capacity
+  /// limit, or beyond the count limit, are freed.
+  void Release(std::vector<uint8_t> buffer);
+
+ private:
+  static constexpr size_t kMaxArenas = 8;
+  static constexpr size_t kMaxArenaCapacity = 4 * 1024 * 1024;
+
+  std::mutex mutex_;
+  std::vector<std::vector<uint8_t>> arenas_;
+};
+
+}  // namespace nodemg
@@ -15,10 +15,18 @@
 #include "client.hpp"
 
 #include <cassert>
+#include <chrono>
+#include <cstring>
+#include <memory>
 #include <optional>
+#include <stdexcept>
+#include <vector>
 
 #include "glue.hpp"
+#include "io_thread.hpp"
 #include "mgclient.hpp"
+#include "snapshot.hpp"
+#include "statement.hpp"
 #include "util.hpp"
 
 namespace nodemg {
@@ -29,9 +37,192 @@ static const std::string CFG_USERNAME = "username";
 static const std::string CFG_PASSWORD = "password";
 static const std::string CFG_CLIENT_NAME = "client_name";
 static const std::string CFG_USE_SSL = "use_ssl";
+static const std::string CFG_IO_THREAD = "io_thread";
+static const std::string CFG_READ_AHEAD = "read_ahead";
+
+static const std::string OPT_LAZY_GRAPH = "lazyGraph";
+static const std::string OPT_INTEGERS = "integers";
+static const std::string OPT_TYPED_LISTS = "typedLists";
+static const std::string OPT_TIME_SLICE = "timeSlice";
 
 Napi::FunctionReference Client::constructor;
 
+using Records = std::vector<std::vector<mg::Value>>;
+
+static std::optional<Napi::Array> MgRecordToNapiArray(
+    DecodeContext &ctx, const std::vector<mg::Value> &record) {
+  auto record_value = Napi::Array::New(ctx.Env(), record.size());
+  for (uint32_t index = 0; index < record.size(); ++index) {
+    auto value = MgValueToNapiValue(ctx, record[index].ptr());
+    if (!value) {
+      return std::nullopt;
+    }
+    record_value[index] = *value;
+  }
+  return record_value;
+}
+
+// Converts fetched records into an Array of Arrays. Sets the JS exception and
+// returns std::nullopt if any of the values can't be converted. The records
+// are taken over because the lazy graph objects keep referencing them.
+static std::optional<Napi::Array> MgRecordsToNapiArray(
+    Napi::Env env, Records &&input_records, const DecodeOptions &options) {
+  auto owned_records = std::make_shared<Records>(std::move(input_records));
+  const auto &records = *owned_records;
+  // A single context for all records, so the repeated keys, labels and edge
+  // types are created only once.
+  DecodeContext ctx(env, options, owned_records);
+  auto output_array_value = Napi::Array::New(env, records.size());
+  for (uint32_t outer_index = 0; outer_index < records.size(); ++outer_index) {
+    auto inner_array_value = MgRecordToNapiArray(ctx, records[outer_index]);
+    if (!inner_array_value) {
+      return std::nullopt;
+    }
+    output_array_value[outer_index] = *inner_array_value;
+  }
+  return output_array_value;
+}
+
+// Converts a large result one time slice per event loop turn, so that timers
+// and I/O aren't held up by a single big result. The first slice is
+// converted right away; if more remain, a Promise of the whole Array is
+// returned and each following slice is scheduled with setImmediate. The
+// converted rows are kept in the output Array. Unless lazy graph objects
+// reference them, the native rows are freed as soon as they're converted.
+class SlicedConversion final
+    : public std::enable_shared_from_this<SlicedConversion> {
+ public:
+  SlicedConversion(Napi::Env env, Records &&records,
+                   const DecodeOptions &options,
+                   std::shared_ptr<ClientStats> stats)
+      : records_(std::make_shared<Records>(std::move(records))),
+        options_(options),
+        stats_(std::move(stats)),
+        deferred_(Napi::Promise::Deferred::New(env)),
+        output_(Napi::Persistent(Napi::Array::New(env, records_->size()))),
+        next_(0) {}
+
+  /// Main thread. Returns the Array if everything fit into the first slice.
+  static Napi::Value Convert(Napi::Env env, Records &&records,
+                             const DecodeOptions &options,
+                             std::shared_ptr<ClientStats> stats) {
+    auto conversion = std::make_shared<SlicedConversion>(
+        env, std::move(records), options, std::move(stats));
+    if (!conversion->Slice(env)) {
+      NODEMG_THROW("Failed to convert fetched data.");
+      return env.Undefined();
+    }
+    if (conversion->Done()) {
+      return conversion->output_.Value();
+    }
+    conversion->Schedule(env);
+    return conversion->deferred_.Promise();
+  }
+
+ private:
+  bool Done() const { return next_ == records_->size(); }
+
+  // Returns false if a value can't be converted.
+  bool Slice(Napi::Env env) {
+    Napi::HandleScope scope(env);
+    auto first = next_;
+    auto converted = ConvertSlice(env);
+    // The context of the slice interns strings which point into the rows, so
+    // they are freed only once it's gone.
+    if (!options_.lazy_graph) {
+      for (auto index = first; index < next_; ++index) {
+        std::vector<mg::Value>().swap((*records_)[index]);
+      }
+    }
+    return converted;
+  }
+
+  bool ConvertSlice(Napi::Env env) {
+    DecodeContext ctx(env, options_,
+                      options_.lazy_graph ? records_ : nullptr);
+    auto output = output_.Value().As<Napi::Array>();
+    auto deadline = StatsClock::now() + options_.time_slice;
+    while (!Done()) {
+      auto record_value = MgRecordToNapiArray(ctx, (*records_)[next_]);
+      if (!record_value) {
+        return false;
+      }
+      output[static_cast<uint32_t>(next_++)] = *record_value;
+      if (StatsClock::now() >= deadline) {
+        break;
+      }
+    }
+    return true;
+  }
+
+  void Schedule(Napi::Env env) {
+    auto self = shared_from_this();
+    auto next =
+        Napi::Function::New(env, [self](const Napi::CallbackInfo &info) {
+          self->Step(info.Env());
+        });
+    env.Global().Get("setImmediate").As<Napi::Function>().Call({next});
+  }
+
+  void Step(Napi::Env env) {
+    auto start = StatsClock::now();
+    try {
+      if (!Slice(env)) {
+        deferred_.Reject(
+            Napi::Error::New(env, "Failed to convert fetched data.").Value());
+      } else if (Done()) {
+        deferred_.Resolve(output_.Value());
+      } else {
+        Schedule(env);
+      }
+    } catch (const Napi::Error &error) {
+      deferred_.Reject(error.Value());
+    }
+    stats_->conversion.Record(ElapsedNanoseconds(start));
+  }
+
+  std::shared_ptr<Records> records_;
+  DecodeOptions options_;
+  std::shared_ptr<ClientStats> stats_;
+  Napi::Promise::Deferred deferred_;
+  Napi::ObjectReference output_;
+  size_t next_;
+};
+
+// The record is taken over because the lazy graph objects keep referencing
+// it.
+static Napi::Value ConvertRecord(Napi::Env env,
+                                 std::vector<mg::Value> &&input_record,
+                                 const DecodeOptions &options) {
+  auto record = std::make_shared<std::vector<mg::Value>>(
+      std::move(input_record));
+  DecodeContext ctx(env, options, record);
+  auto record_value = MgRecordToNapiArray(ctx, *record);
+  if (!record_value) {
+    NODEMG_THROW("Failed to convert fetched data.");
+    return env.Undefined();
+  }
+  return *record_value;
+}
+
+// The Array of all records, or a Promise of it when the conversion is time
+// sliced.
+static Napi::Value ConvertRecords(Napi::Env env, Records &&records,
+                                  const DecodeOptions &options,
+                                  std::shared_ptr<ClientStats> stats) {
+  if (options.time_slice.count() > 0) {
+    return SlicedConversion::Convert(env, std::move(records), options,
+                                     std::move(stats));
+  }
+  auto output_array_value =
+      MgRecordsToNapiArray(env, std::move(records), options);
+  if (!output_array_value) {
+    NODEMG_THROW("Failed to convert fetched data.");
+    return env.Undefined();
+  }
+  return *output_array_value;
+}
+
 Napi::Object Client::Init(Napi::Env env, Napi::Object exports) {
   Napi::HandleScope scope(env);
 
@@ -43,9 +234,21 @@ Napi::Object Client::Init(Napi::Env env, Napi::Object exports) {
                       InstanceMethod("FetchAll", &Client::FetchAll),
                       InstanceMethod("DiscardAll", &Client::DiscardAll),
                       InstanceMethod("FetchOne", &Client::FetchOne),
+                      InstanceMethod("FetchBatch", &Client::FetchBatch),
+                      InstanceMethod("FetchColumns", &Client::FetchColumns),
+                      InstanceMethod("FetchSnapshot", &Client::FetchSnapshot),
+                      InstanceMethod("ExecuteAndFetchAll",
+                                     &Client::ExecuteAndFetchAll),
+                      InstanceMethod("ExecuteAndDiscardAll",
+                                     &Client::ExecuteAndDiscardAll),
+                      InstanceMethod("ExecuteMany", &Client::ExecuteMany),
                       InstanceMethod("Begin", &Client::Begin),
                       InstanceMethod("Commit", &Client::Commit),
                       InstanceMethod("Rollback", &Client::Rollback),
+                      InstanceMethod("SetOptions", &Client::SetOptions),
+                      InstanceMethod("Prepare", &Client::Prepare),
+                      InstanceMethod("Stats", &Client::Stats),
+                      InstanceMethod("ResetStats", &Client::ResetStats),
                   });
 
   constructor = Napi::Persistent(func);
@@ -61,27 +264,25 @@ Napi::Object Client::NewInstance(const Napi::CallbackInfo &info) {
   return scope.Escape(napi_value(obj)).ToObject();
 }
 
-std::optional<mg::Client::Params> Client::PrepareConnect(
-    const Napi::CallbackInfo &info) {
-  Napi::Env env = info.Env();
-
+std::optional<mg::Client::Params> NapiObjectToMgClientParams(
+    Napi::Env env, Napi::Value input, const std::string &user_agent) {
   mg::Client::Params mg_params;
-  mg_params.user_agent = name_;
+  mg_params.user_agent = user_agent;
 
-  if (info.Length() < 1) {
+  if (input.IsEmpty() || input.IsUndefined()) {
     return mg_params;
   }
 
   static const std::string NODEMG_MSG_WRONG_CONNECT_ARG =
       "Wrong connect argument. An object containing { host, port, username, "
-      "password, client_name, use_ssl } is required. All arguments are "
-      "optional.";
-  if (!info[0].IsObject()) {
+      "password, client_name, use_ssl, io_thread, read_ahead } is required. "
+      "All arguments are optional.";
+  if (!input.IsObject()) {
     NODEMG_THROW(NODEMG_MSG_WRONG_CONNECT_ARG);
     return std::nullopt;
   }
 
-  Napi::Object user_params = info[0].As<Napi::Object>();
+  Napi::Object user_params = input.As<Napi::Object>();
   // Used to report an error if user misspelled any argument.
   uint32_t counter = 0;
 
@@ -155,6 +356,28 @@ std::optional<mg::Client::Params> Client::PrepareConnect(
     }
   }
 
+  if (user_params.Has(CFG_IO_THREAD)) {
+    counter++;
+    if (!user_params.Get(CFG_IO_THREAD).IsBoolean()) {
+      NODEMG_THROW("`io_thread` connect argument has to be boolean.");
+      return std::nullopt;
+    }
+  }
+
+  if (user_params.Has(CFG_READ_AHEAD)) {
+    counter++;
+    auto napi_read_ahead = user_params.Get(CFG_READ_AHEAD);
+    auto read_ahead = napi_read_ahead.IsNumber()
+                          ? napi_read_ahead.ToNumber().DoubleValue()
+                          : -1.0;
+    if (!(read_ahead >= 0.0 && read_ahead <= 1e6)) {
+      NODEMG_THROW(
+          "`read_ahead` connect argument has to be a number between 0 and "
+          "1000000.");
+      return std::nullopt;
+    }
+  }
+
   if (user_params.GetPropertyNames().Length() != counter) {
     NODEMG_THROW(NODEMG_MSG_WRONG_CONNECT_ARG);
     return std::nullopt;
@@ -163,14 +386,141 @@ std::optional<mg::Client::Params> Client::PrepareConnect(
   return mg_params;
 }
 
-std::optional<std::pair<std::string, mg::ConstMap>> Client::PrepareQuery(
+ClientSettings NapiObjectToClientSettings(Napi::Value input) {
+  ClientSettings settings;
+  if (input.IsEmpty() || !input.IsObject()) {
+    return settings;
+  }
+  auto user_params = input.As<Napi::Object>();
+  if (user_params.Has(CFG_IO_THREAD)) {
+    settings.io_thread = user_params.Get(CFG_IO_THREAD).ToBoolean();
+  }
+  if (user_params.Has(CFG_READ_AHEAD)) {
+    settings.read_ahead =
+        user_params.Get(CFG_READ_AHEAD).ToNumber().Uint32Value();
+  }
+  return settings;
+}
+
+std::optional<DecodeOptions> NapiObjectToDecodeOptions(
+    Napi::Env env, Napi::Value input, const DecodeOptions &defaults) {
+  DecodeOptions options = defaults;
+
+  if (input.IsEmpty() || input.IsUndefined()) {
+    return options;
+  }
+
+  static const std::string NODEMG_MSG_WRONG_OPTIONS_ARG =
+      "Wrong options argument. An object containing { integers, lazyGraph, "
+      "typedLists, timeSlice } is required. All options are optional.";
+  if (!input.IsObject()) {
+    NODEMG_THROW(NODEMG_MSG_WRONG_OPTIONS_ARG);
+    return std::nullopt;
+  }
+
+  Napi::Object user_options = input.As<Napi::Object>();
+  // Used to report an error if user misspelled any option.
+  uint32_t counter = 0;
+
+  if (user_options.Has(OPT_INTEGERS)) {
+    counter++;
+    static const std::string NODEMG_MSG_WRONG_INTEGERS_OPTION =
+        "`integers` option has to be one of 'bigint', 'number' or 'auto'.";
+    auto napi_integers = user_options.Get(OPT_INTEGERS);
+    if (!napi_integers.IsString()) {
+      NODEMG_THROW(NODEMG_MSG_WRONG_INTEGERS_OPTION);
+      return std::nullopt;
+    }
+    auto integers = napi_integers.ToString().Utf8Value();
+    if (integers == "bigint") {
+      options.integers = DecodeOptions::Integers::BigInt;
+    } else if (integers == "number") {
+      options.integers = DecodeOptions::Integers::Number;
+    } else if (integers == "auto") {
+      options.integers = DecodeOptions::Integers::Auto;
+    } else {
+      NODEMG_THROW(NODEMG_MSG_WRONG_INTEGERS_OPTION);
+      return std::nullopt;
+    }
+  }
+
+  if (user_options.Has(OPT_LAZY_GRAPH)) {
+    counter++;
+    auto napi_lazy_graph = user_options.Get(OPT_LAZY_GRAPH);
+    if (!napi_lazy_graph.IsBoolean()) {
+      NODEMG_THROW("`lazyGraph` option has to be boolean.");
+      return std::nullopt;
+    }
+    options.lazy_graph = napi_lazy_graph.ToBoolean();
+  }
+
+  if (user_options.Has(OPT_TYPED_LISTS)) {
+    counter++;
+    auto napi_typed_lists = user_options.Get(OPT_TYPED_LISTS);
+    if (!napi_typed_lists.IsBoolean()) {
+      NODEMG_THROW("`typedLists` option has to be boolean.");
+      return std::nullopt;
+    }
+    options.typed_lists = napi_typed_lists.ToBoolean();
+  }
+
+  if (user_options.Has(OPT_TIME_SLICE)) {
+    counter++;
+    auto napi_time_slice = user_options.Get(OPT_TIME_SLICE);
+    auto time_slice = napi_time_slice.IsNumber()
+                          ? napi_time_slice.ToNumber().DoubleValue()
+                          : -1.0;
+    // Up to an hour, anything longer doesn't slice anyway.
+    if (!(time_slice >= 0.0 && time_slice <= 3.6e9)) {
+      NODEMG_THROW(
+          "`timeSlice` option has to be a number of microseconds between 0 "
+          "and 3600000000.");
+      return std::nullopt;
+    }
+    options.time_slice =
+        std::chrono::microseconds(static_cast<int64_t>(time_slice));
+  }
+
+  if (user_options.GetPropertyNames().Length() != counter) {
+    NODEMG_THROW(NODEMG_MSG_WRONG_OPTIONS_ARG);
+    return std::nullopt;
+  }
+
+  return options;
+}
+
+std::optional<DecodeOptions> Client::PrepareDecodeOptions(
+    const Napi::CallbackInfo &info, size_t index) {
+  if (info.Length() <= index) {
+    return decode_options_;
+  }
+  return NapiObjectToDecodeOptions(info.Env(), info[index], decode_options_);
+}
+
+Napi::Value Client::SetOptions(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  auto options = PrepareDecodeOptions(info, 0);
+  if (options) {
+    decode_options_ = *options;
+  }
+  return env.Undefined();
+}
+
+std::optional<mg::Client::Params> Client::PrepareConnect(
     const Napi::CallbackInfo &info) {
+  if (info.Length() < 1) {
+    return NapiObjectToMgClientParams(info.Env(), Napi::Value(), name_);
+  }
+  return NapiObjectToMgClientParams(info.Env(), info[0], name_);
+}
+
+std::optional<Query> Client::PrepareQuery(const Napi::CallbackInfo &info) {
   Napi::Env env = info.Env();
 
   std::string query;
-  mg_map *query_params = NULL;
+  ParamSnapshot query_params;
 
-  if (info.Length() == 1 || info.Length() == 2) {
+  if (info.Length() >= 1) {
     auto maybe_query = info[0];
     if (!maybe_query.IsString()) {
       NODEMG_THROW("The first execute argument has to be string.");
@@ -179,7 +529,7 @@ std::optional<std::pair<std::string, mg::ConstMap>> Client::PrepareQuery(
     query = maybe_query.As<Napi::String>().Utf8Value();
   }
 
-  if (info.Length() == 2) {
+  if (info.Length() >= 2) {
     auto maybe_params = info[1];
     if (!maybe_params.IsObject()) {
       NODEMG_THROW(
@@ -187,20 +537,39 @@ std::optional<std::pair<std::string, mg::ConstMap>> Client::PrepareQuery(
           "parameters.");
       return std::nullopt;
     }
-    auto params = maybe_params.As<Napi::Object>();
-    auto maybe_mg_params = NapiObjectToMgMap(env, params);
-    if (!maybe_mg_params) {
-      NODEMG_THROW("Unable to create query parameters object.");
+    auto maybe_params_snapshot =
+        PrepareParams(env, maybe_params.As<Napi::Object>());
+    if (!maybe_params_snapshot) {
       return std::nullopt;
     }
-    query_params = *maybe_mg_params;
+    query_params = std::move(*maybe_params_snapshot);
   }
 
-  return std::make_pair(query, mg::ConstMap(query_params));
+  return Query{std::make_shared<const std::string>(std::move(query)),
+               std::move(query_params)};
+}
+
+std::optional<ParamSnapshot> Client::PrepareParams(Napi::Env env,
+                                                   Napi::Object params) {
+  auto start = StatsClock::now();
+  auto params_snapshot = NapiObjectToParamSnapshot(env, params, arenas_);
+  stats_->encoding.Record(ElapsedNanoseconds(start));
+  if (!params_snapshot) {
+    NODEMG_THROW("Unable to create query parameters object.");
+    return std::nullopt;
+  }
+  return params_snapshot;
 }
 
 Client::Client(const Napi::CallbackInfo &info)
-    : Napi::ObjectWrap<Client>(info), client_(nullptr), name_("nodemgclient") {
+    : Napi::ObjectWrap<Client>(info),
+      client_(nullptr),
+      name_("nodemgclient"),
+      running_(false),
+      arenas_(std::make_shared<ArenaPool>()),
+      stats_(std::make_shared<ClientStats>()),
+      read_ahead_(
+          std::make_shared<ReadAheadBuffer>(ClientSettings().read_ahead)) {
   if (info.Length() == 1) {
     name_ = info[0].As<Napi::String>().Utf8Value();
   }
@@ -212,14 +581,24 @@ void Client::SetMgClient(std::unique_ptr<mg::Client> client) {
   this->client_ = std::move(client);
 }
 
+void Client::Configure(Napi::Env env, const ClientSettings &settings) {
+  if (settings.read_ahead != read_ahead_->Capacity()) {
+    read_ahead_ = std::make_shared<ReadAheadBuffer>(settings.read_ahead);
+  }
+  if (settings.io_thread && !io_thread_) {
+    io_thread_ = std::make_unique<IoThread>(env, this, client_.get());
+  }
+}
+
 class AsyncConnectWorker final : public Napi::AsyncWorker {
  public:
   AsyncConnectWorker(const Napi::Promise::Deferred &deferred,
-                     mg::Client::Params params)
+                     mg::Client::Params params, ClientSettings settings)
       : AsyncWorker(Napi::Function::New(deferred.Promise().Env(),
                                         [](const Napi::CallbackInfo &) {})),
         deferred_(deferred),
-        params_(std::move(params)) {}
+        params_(std::move(params)),
+        settings_(settings) {}
   ~AsyncConnectWorker() = default;
 
   void Execute() {
@@ -243,6 +622,7 @@ class AsyncConnectWorker final : public Napi::AsyncWorker {
     Napi::Object obj = Client::constructor.New({});
     Client *async_connection = Client::Unwrap(obj);
     async_connection->SetMgClient(std::move(client_));
+    async_connection->Configure(Env(), settings_);
     this->deferred_.Resolve(obj);
   }
 
@@ -253,6 +633,7 @@ class AsyncConnectWorker final : public Napi::AsyncWorker {
  private:
   Napi::Promise::Deferred deferred_;
   mg::Client::Params params_;
+  ClientSettings settings_;
   std::unique_ptr<mg::Client> client_;
 };
 
@@ -270,253 +651,1036 @@ Napi::Value Client::Connect(const Napi::CallbackInfo &info) {
   }
 
   Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(info.Env());
-  AsyncConnectWorker *wk = new AsyncConnectWorker(deferred, std::move(*params));
+  auto settings = info.Length() > 0 ? NapiObjectToClientSettings(info[0])
+                                    : ClientSettings();
+  AsyncConnectWorker *wk =
+      new AsyncConnectWorker(deferred, std::move(*params), settings);
   wk->Queue();
   return deferred.Promise();
 }
 
-class AsyncExecuteWorker final : public Napi::AsyncWorker {
+Command::Command(const Napi::Promise::Deferred &deferred)
+    : deferred_(deferred), enqueued_(StatsClock::now()) {}
+
+Napi::Value Command::OnOK(Napi::Env env) { return env.Null(); }
+
+void Command::CountRecord(const std::vector<mg::Value> &record) {
+  ++rows_;
+  for (const auto &value : record) {
+    bytes_ += MgValuePayloadBytes(value.ptr());
+  }
+}
+
+void Command::Attach(std::shared_ptr<ReadAheadBuffer> read_ahead) {
+  read_ahead_ = std::move(read_ahead);
+  if (!Background()) {
+    read_ahead_->Hold();
+  }
+}
+
+void Command::Detach() {
+  if (read_ahead_ && !Background()) {
+    read_ahead_->Unhold();
+  }
+}
+
+std::optional<std::vector<mg::Value>> Command::NextRecord(
+    mg::Client *client) {
+  if (auto record = read_ahead_->Pop()) {
+    return record;
+  }
+  if (read_ahead_->TakeEnd()) {
+    return std::nullopt;
+  }
+  auto record = client->FetchOne();
+  if (record) {
+    CountRecord(*record);
+  }
+  return record;
+}
+
+std::optional<std::vector<std::vector<mg::Value>>> Command::RemainingRecords(
+    mg::Client *client) {
+  auto records = read_ahead_->TakeAll();
+  if (read_ahead_->TakeEnd()) {
+    return records;
+  }
+  auto rest = client->FetchAll();
+  if (rest) {
+    for (const auto &record : *rest) {
+      CountRecord(record);
+    }
+  }
+  if (records.empty()) {
+    return rest;
+  }
+  if (rest) {
+    std::move(rest->begin(), rest->end(), std::back_inserter(records));
+  }
+  return records;
+}
+
+void Command::DiscardRemaining(mg::Client *client) {
+  read_ahead_->TakeAll();
+  if (!read_ahead_->TakeEnd()) {
+    client->DiscardAll();
+  }
+}
+
+void Command::ReadAhead(mg::Client *client) {
+  try {
+    while (!read_ahead_->Full() && !read_ahead_->Ended()) {
+      auto record = client->FetchOne();
+      if (!record) {
+        read_ahead_->SetEnd();
+        break;
+      }
+      CountRecord(*record);
+      read_ahead_->Push(std::move(*record));
+    }
+  } catch (const std::exception &error) {
+    read_ahead_->SetEnd(error.what());
+  }
+}
+
+void Command::ResetReadAhead() { read_ahead_->Reset(); }
+
+void RunCommand(mg::Client *mg_client, Command &command, ClientStats &stats) {
+  auto start = StatsClock::now();
+  try {
+    command.Execute(mg_client);
+  } catch (const std::exception &error) {
+    command.SetError(error.what());
+  }
+  stats.network.Record(ElapsedNanoseconds(start));
+  ++stats.commands;
+  stats.rows += command.Rows();
+  stats.bytes += command.Bytes();
+}
+
+void SettleCommand(Napi::Env env, Command &command, ClientStats &stats) {
+  Napi::HandleScope scope(env);
+  command.Detach();
+  const auto &deferred = command.Deferred();
+  if (command.Error()) {
+    ++stats.errors;
+    deferred.Reject(Napi::Error::New(env, *command.Error()).Value());
+    return;
+  }
+  auto start = StatsClock::now();
+  try {
+    deferred.Resolve(command.OnOK(env));
+  } catch (const Napi::Error &error) {
+    ++stats.errors;
+    deferred.Reject(error.Value());
+  }
+  stats.conversion.Record(ElapsedNanoseconds(start));
+}
+
+// Executes a batch of commands one after another within a single threadpool
+// job and settles their Promises in the same order.
+class AsyncCommandWorker final : public Napi::AsyncWorker {
  public:
-  AsyncExecuteWorker(const Napi::Promise::Deferred &deferred,
-                     mg::Client *client, std::string query, mg::ConstMap params)
-      : AsyncWorker(Napi::Function::New(deferred.Promise().Env(),
-                                        [](const Napi::CallbackInfo &) {})),
-        deferred_(deferred),
+  AsyncCommandWorker(Napi::Env env, Client *client, mg::Client *mg_client,
+                     std::vector<std::unique_ptr<Command>> commands)
+      : AsyncWorker(env),
         client_(client),
-        query_(std::move(query)),
-        params_(std::move(params)) {}
-  ~AsyncExecuteWorker() = default;
+        client_ref_(Napi::Persistent(client->Value())),
+        mg_client_(mg_client),
+        commands_(std::move(commands)),
+        stats_(client->Metrics()),
+        queued_(StatsClock::now()) {}
+  ~AsyncCommandWorker() = default;
 
   void Execute() {
+    stats_->threadpool_wait.Record(ElapsedNanoseconds(queued_));
+    for (auto &command : commands_) {
+      stats_->queue_wait.Record(static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              queued_ - command->Enqueued())
+              .count()));
+      RunCommand(mg_client_, *command, *stats_);
+    }
+  }
+
+  void OnOK() {
+    auto env = Env();
+    for (auto &command : commands_) {
+      SettleCommand(env, *command, *stats_);
+    }
+    commands_.clear();
+    client_->OnCommandsDone();
+  }
+
+ private:
+  Client *client_;
+  // Keeps the Client (and the underlying connection) alive while the
+  // commands are executed.
+  Napi::ObjectReference client_ref_;
+  mg::Client *mg_client_;
+  std::vector<std::unique_ptr<Command>> commands_;
+  std::shared_ptr<ClientStats> stats_;
+  StatsClock::time_point queued_;
+};
+
+Napi::Value Client::Enqueue(Napi::Env env, std::unique_ptr<Command> command) {
+  if (!client_) {
+    NODEMG_THROW("Client is not connected.");
+    return env.Undefined();
+  }
+  auto promise = command->Deferred().Promise();
+  command->Attach(read_ahead_);
+  if (io_thread_) {
+    io_thread_->Push(env, std::move(command));
+    return promise;
+  }
+  pending_.emplace_back(std::move(command));
+  Flush();
+  return promise;
+}
+
+void Client::Flush() {
+  if (running_ || pending_.empty()) {
+    return;
+  }
+  running_ = true;
+  // Everything issued while the previous batch was running goes out together.
+  auto wk = new AsyncCommandWorker(Env(), this, client_.get(),
+                                   std::move(pending_));
+  pending_.clear();
+  wk->Queue();
+}
+
+void Client::OnCommandsDone() {
+  running_ = false;
+  Flush();
+}
+
+class ExecuteCommand final : public Command {
+ public:
+  ExecuteCommand(const Napi::Promise::Deferred &deferred, Query query)
+      : Command(deferred), query_(std::move(query)) {}
+
+  void Execute(mg::Client *client) override {
     static const std::string NODEMG_MSG_EXECUTE_FAIL =
         "Failed to execute a query.";
+    ResetReadAhead();
     try {
-      auto status = client_->Execute(query_, params_);
-      if (!status) {
+      auto params = query_.params.Build();
+      auto columns =
+          client->Execute(*query_.text, mg::ConstMap(params.get()));
+      if (!columns) {
         SetError(NODEMG_MSG_EXECUTE_FAIL);
         return;
       }
+      Buffer().SetFields(columns->size());
     } catch (const std::exception &error) {
       SetError(NODEMG_MSG_EXECUTE_FAIL + " " + error.what());
       return;
     }
   }
 
-  void OnOK() {
-    auto env = deferred_.Env();
-    this->deferred_.Resolve(env.Null());
+ private:
+  Query query_;
+};
+
+Napi::Value Client::Execute(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+
+  auto query = PrepareQuery(info);
+  if (!query) {
+    return env.Undefined();
   }
 
-  void OnError(const Napi::Error &e) {
-    this->deferred_.Reject(Napi::Error::New(Env(), e.Message()).Value());
+  return EnqueueQuery(env, std::move(*query), ResultMode::Keep,
+                      decode_options_);
+}
+
+// Runs the query and pulls the whole result as one command, which saves one
+// Promise and one event loop turn compared to Execute followed by FetchAll.
+class ExecuteAndFetchAllCommand final : public Command {
+ public:
+  ExecuteAndFetchAllCommand(const Napi::Promise::Deferred &deferred,
+                            Query query, DecodeOptions options,
+                            std::shared_ptr<ClientStats> stats)
+      : Command(deferred),
+        query_(std::move(query)),
+        options_(options),
+        stats_(std::move(stats)) {}
+
+  void Execute(mg::Client *client) override {
+    static const std::string NODEMG_MSG_EXECUTE_FAIL =
+        "Failed to execute a query.";
+    static const std::string NODEMG_MSG_FETCH_ALL_FAIL =
+        "Failed to fetch all records.";
+    ResetReadAhead();
+    try {
+      auto params = query_.params.Build();
+      auto status = client->Execute(*query_.text, mg::ConstMap(params.get()));
+      if (!status) {
+        SetError(NODEMG_MSG_EXECUTE_FAIL);
+        return;
+      }
+    } catch (const std::exception &error) {
+      SetError(NODEMG_MSG_EXECUTE_FAIL + " " + error.what());
+      return;
+    }
+    try {
+      data_ = client->FetchAll();
+    } catch (const std::exception &error) {
+      SetError(NODEMG_MSG_FETCH_ALL_FAIL + " " + error.what());
+      return;
+    }
+    if (data_) {
+      for (const auto &record : *data_) {
+        CountRecord(record);
+      }
+    }
+  }
+
+  Napi::Value OnOK(Napi::Env env) override {
+    if (!data_) {
+      return env.Null();
+    }
+    return ConvertRecords(env, std::move(*data_), options_, stats_);
   }
 
  private:
-  Napi::Promise::Deferred deferred_;
-  mg::Client *client_;
-  std::string query_;
-  mg::ConstMap params_;
+  Query query_;
+  DecodeOptions options_;
+  std::shared_ptr<ClientStats> stats_;
+  std::optional<Records> data_;
 };
 
-Napi::Value Client::Execute(const Napi::CallbackInfo &info) {
+Napi::Value Client::ExecuteAndFetchAll(const Napi::CallbackInfo &info) {
   auto env = info.Env();
 
-  auto query_params = PrepareQuery(info);
-  if (!query_params) {
-    return info.Env().Undefined();
+  auto query = PrepareQuery(info);
+  if (!query) {
+    return env.Undefined();
+  }
+  auto options = PrepareDecodeOptions(info, 2);
+  if (!options) {
+    return env.Undefined();
   }
 
-  Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
-  auto wk = new AsyncExecuteWorker(deferred, client_.get(),
-                                   std::move(query_params->first),
-                                   std::move(query_params->second));
-  wk->Queue();
-  return deferred.Promise();
+  return EnqueueQuery(env, std::move(*query), ResultMode::FetchAll, *options);
 }
 
-class AsyncFetchAllWorker final : public Napi::AsyncWorker {
+class ExecuteAndDiscardAllCommand final : public Command {
  public:
-  AsyncFetchAllWorker(const Napi::Promise::Deferred &deferred,
-                      mg::Client *client)
-      : AsyncWorker(Napi::Function::New(deferred.Promise().Env(),
-                                        [](const Napi::CallbackInfo &) {})),
-        deferred_(deferred),
-        client_(client) {}
-  ~AsyncFetchAllWorker() = default;
+  ExecuteAndDiscardAllCommand(const Napi::Promise::Deferred &deferred,
+                              Query query)
+      : Command(deferred), query_(std::move(query)) {}
 
-  void Execute() {
-    static const std::string NODEMG_MSG_FETCH_ONE_FAIL =
-        "Failed to fetch one record.";
+  void Execute(mg::Client *client) override {
+    static const std::string NODEMG_MSG_EXECUTE_FAIL =
+        "Failed to execute a query.";
+    static const std::string NODEMG_MSG_DISCARD_ALL_FAIL =
+        "Failed to discard all data.";
+    ResetReadAhead();
     try {
-      data_ = client_->FetchAll();
+      auto params = query_.params.Build();
+      auto status = client->Execute(*query_.text, mg::ConstMap(params.get()));
+      if (!status) {
+        SetError(NODEMG_MSG_EXECUTE_FAIL);
+        return;
+      }
     } catch (const std::exception &error) {
-      SetError(NODEMG_MSG_FETCH_ONE_FAIL + error.what());
+      SetError(NODEMG_MSG_EXECUTE_FAIL + " " + error.what());
+      return;
+    }
+    try {
+      client->DiscardAll();
+    } catch (const std::exception &error) {
+      SetError(NODEMG_MSG_DISCARD_ALL_FAIL + " " + error.what());
       return;
     }
   }
 
-  void OnOK() {
-    auto env = deferred_.Env();
+ private:
+  Query query_;
+};
 
-    if (!data_) {
-      this->deferred_.Resolve(env.Null());
+Napi::Value Client::ExecuteAndDiscardAll(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+
+  auto query = PrepareQuery(info);
+  if (!query) {
+    return env.Undefined();
+  }
+
+  return EnqueueQuery(env, std::move(*query), ResultMode::DiscardAll,
+                      decode_options_);
+}
+
+// Runs a list of queries, each followed by FetchAll, as a single command, so
+// a fan-out of small queries costs one Promise and one worker hop. Every
+// query gets its own result or error. In a transaction the queries after a
+// failed one aren't executed and the transaction is rolled back.
+class ExecuteManyCommand final : public Command {
+ public:
+  ExecuteManyCommand(const Napi::Promise::Deferred &deferred,
+                     std::vector<Query> queries, bool transactional,
+                     DecodeOptions options)
+      : Command(deferred),
+        queries_(std::move(queries)),
+        transactional_(transactional),
+        options_(options) {}
+
+  void Execute(mg::Client *client) override {
+    static const std::string NODEMG_MSG_TXOP_FAIL =
+        "Fail to execute transaction operation.";
+    ResetReadAhead();
+    results_.resize(queries_.size());
+    try {
+      if (transactional_ && !client->BeginTransaction()) {
+        SetError("Fail to BEGIN transaction.");
+        return;
+      }
+    } catch (const std::exception &error) {
+      SetError(NODEMG_MSG_TXOP_FAIL + " " + error.what());
+      return;
+    }
+    bool failed = false;
+    for (size_t index = 0; index < queries_.size(); ++index) {
+      if (failed && transactional_) {
+        results_[index].error =
+            "Not executed, the transaction was rolled back.";
+        continue;
+      }
+      Run(client, queries_[index], results_[index]);
+      failed = failed || results_[index].error.has_value();
+    }
+    if (!transactional_) {
+      return;
+    }
+    if (failed) {
+      try {
+        // The server may have aborted the transaction already.
+        client->RollbackTransaction();
+      } catch (const std::exception &) {
+      }
       return;
     }
+    try {
+      if (!client->CommitTransaction()) {
+        SetError("Fail to COMMIT transaction.");
+      }
+    } catch (const std::exception &error) {
+      SetError(NODEMG_MSG_TXOP_FAIL + " " + error.what());
+    }
+  }
 
-    auto output_array_value = Napi::Array::New(env, data_->size());
-    for (uint32_t outer_index = 0; outer_index < data_->size(); ++outer_index) {
-      auto inner_array = (*data_)[outer_index];
-      auto inner_array_size = inner_array.size();
-      auto inner_array_value = Napi::Array::New(env, inner_array_size);
-      for (uint32_t inner_index = 0; inner_index < inner_array_size;
-           ++inner_index) {
-        auto value = MgValueToNapiValue(env, inner_array[inner_index].ptr());
-        if (!value) {
-          SetError("Failed to convert fetched data.");
-          return;
+  Napi::Value OnOK(Napi::Env env) override {
+    static const std::string KEY_RECORDS = "records";
+    static const std::string KEY_ERROR = "error";
+    auto output = Napi::Array::New(env, results_.size());
+    for (uint32_t index = 0; index < results_.size(); ++index) {
+      auto &result = results_[index];
+      auto entry = Napi::Object::New(env);
+      if (result.error) {
+        entry.Set(KEY_ERROR, Napi::Error::New(env, *result.error).Value());
+      } else {
+        auto records = MgRecordsToNapiArray(
+            env, std::move(result.records), options_);
+        if (!records) {
+          NODEMG_THROW("Failed to convert fetched data.");
+          return env.Undefined();
         }
-        inner_array_value[inner_index] = *value;
+        entry.Set(KEY_RECORDS, *records);
       }
-      output_array_value[outer_index] = inner_array_value;
+      output[index] = entry;
     }
+    return output;
+  }
+
+ private:
+  struct Result {
+    Records records;
+    std::optional<std::string> error;
+  };
 
-    this->deferred_.Resolve(output_array_value);
+  void Run(mg::Client *client, const Query &query, Result &result) {
+    static const std::string NODEMG_MSG_EXECUTE_FAIL =
+        "Failed to execute a query.";
+    static const std::string NODEMG_MSG_FETCH_ALL_FAIL =
+        "Failed to fetch all records.";
+    try {
+      auto params = query.params.Build();
+      if (!client->Execute(*query.text, mg::ConstMap(params.get()))) {
+        result.error = NODEMG_MSG_EXECUTE_FAIL;
+        return;
+      }
+    } catch (const std::exception &error) {
+      result.error = NODEMG_MSG_EXECUTE_FAIL + " " + error.what();
+      return;
+    }
+    try {
+      auto records = client->FetchAll();
+      if (records) {
+        for (const auto &record : *records) {
+          CountRecord(record);
+        }
+        result.records = std::move(*records);
+      }
+    } catch (const std::exception &error) {
+      result.error = NODEMG_MSG_FETCH_ALL_FAIL + " " + error.what();
+    }
   }
 
-  void OnError(const Napi::Error &e) {
-    this->deferred_.Reject(Napi::Error::New(Env(), e.Message()).Value());
+  std::vector<Query> queries_;
+  bool transactional_;
+  DecodeOptions options_;
+  std::vector<Result> results_;
+};
+
+Napi::Value Client::ExecuteMany(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+
+  static const std::string NODEMG_MSG_WRONG_STATEMENTS_ARG =
+      "ExecuteMany requires an array of { query, params } objects.";
+  if (info.Length() < 1 || !info[0].IsArray()) {
+    NODEMG_THROW(NODEMG_MSG_WRONG_STATEMENTS_ARG);
+    return env.Undefined();
+  }
+  auto statements = info[0].As<Napi::Array>();
+  std::vector<Query> queries;
+  queries.reserve(statements.Length());
+  for (uint32_t index = 0; index < statements.Length(); ++index) {
+    Napi::Value statement = statements[index];
+    if (!statement.IsObject()) {
+      NODEMG_THROW(NODEMG_MSG_WRONG_STATEMENTS_ARG);
+      return env.Undefined();
+    }
+    auto query = statement.As<Napi::Object>().Get("query");
+    auto params = statement.As<Napi::Object>().Get("params");
+    if (!query.IsString() ||
+        !(params.IsUndefined() || params.IsObject())) {
+      NODEMG_THROW(NODEMG_MSG_WRONG_STATEMENTS_ARG);
+      return env.Undefined();
+    }
+    ParamSnapshot query_params;
+    if (params.IsObject()) {
+      auto params_snapshot = PrepareParams(env, params.As<Napi::Object>());
+      if (!params_snapshot) {
+        return env.Undefined();
+      }
+      query_params = std::move(*params_snapshot);
+    }
+    queries.push_back(
+        Query{std::make_shared<const std::string>(
+                  query.As<Napi::String>().Utf8Value()),
+              std::move(query_params)});
+  }
+  bool transactional = info.Length() >= 2 && info[1].ToBoolean();
+  auto options = PrepareDecodeOptions(info, 2);
+  if (!options) {
+    return env.Undefined();
+  }
+  // The results are converted at once, they are many but small.
+  options->time_slice = std::chrono::microseconds(0);
+
+  stats_->queries += queries.size();
+  return Enqueue(env, std::make_unique<ExecuteManyCommand>(
+                          Napi::Promise::Deferred::New(env),
+                          std::move(queries), transactional, *options));
+}
+
+Napi::Value Client::EnqueueQuery(Napi::Env env, Query query, ResultMode mode,
+                                 const DecodeOptions &options) {
+  ++stats_->queries;
+  auto deferred = Napi::Promise::Deferred::New(env);
+  switch (mode) {
+    case ResultMode::FetchAll:
+      return Enqueue(env, std::make_unique<ExecuteAndFetchAllCommand>(
+                              deferred, std::move(query), options, stats_));
+    case ResultMode::DiscardAll:
+      return Enqueue(env, std::make_unique<ExecuteAndDiscardAllCommand>(
+                              deferred, std::move(query)));
+    default:
+      return Enqueue(
+          env, std::make_unique<ExecuteCommand>(deferred, std::move(query)));
+  }
+}
+
+Napi::Value Client::Prepare(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  if (info.Length() != 1 || !info[0].IsString()) {
+    NODEMG_THROW("Prepare requires the query as a string argument.");
+    return env.Undefined();
+  }
+  return Statement::New(env, this, Value(), info[0].As<Napi::String>());
+}
+
+Napi::Value Client::Stats(const Napi::CallbackInfo &info) {
+  return stats_->ToNapiObject(info.Env());
+}
+
+Napi::Value Client::ResetStats(const Napi::CallbackInfo &info) {
+  stats_->Reset();
+  return info.Env().Undefined();
+}
+
+class FetchAllCommand final : public Command {
+ public:
+  FetchAllCommand(const Napi::Promise::Deferred &deferred,
+                  DecodeOptions options, std::shared_ptr<ClientStats> stats)
+      : Command(deferred), options_(options), stats_(std::move(stats)) {}
+
+  void Execute(mg::Client *client) override {
+    static const std::string NODEMG_MSG_FETCH_ALL_FAIL =
+        "Failed to fetch all records.";
+    try {
+      data_ = RemainingRecords(client);
+    } catch (const std::exception &error) {
+      SetError(NODEMG_MSG_FETCH_ALL_FAIL + " " + error.what());
+      return;
+    }
+  }
+
+  Napi::Value OnOK(Napi::Env env) override {
+    if (!data_) {
+      return env.Null();
+    }
+    return ConvertRecords(env, std::move(*data_), options_, stats_);
   }
 
  private:
-  Napi::Promise::Deferred deferred_;
-  mg::Client *client_;
-  decltype(client_->FetchAll()) data_;
+  DecodeOptions options_;
+  std::shared_ptr<ClientStats> stats_;
+  std::optional<Records> data_;
 };
 
 Napi::Value Client::FetchAll(const Napi::CallbackInfo &info) {
-  Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(info.Env());
-  auto wk = new AsyncFetchAllWorker(deferred, client_.get());
-  wk->Queue();
-  return deferred.Promise();
+  auto env = info.Env();
+  auto options = PrepareDecodeOptions(info, 0);
+  if (!options) {
+    return env.Undefined();
+  }
+  return Enqueue(env,
+                 std::make_unique<FetchAllCommand>(
+                     Napi::Promise::Deferred::New(env), *options, stats_));
 }
 
-class AsyncDiscardAllWorker final : public Napi::AsyncWorker {
+class DiscardAllCommand final : public Command {
  public:
-  AsyncDiscardAllWorker(const Napi::Promise::Deferred &deferred,
-                        mg::Client *client)
-      : AsyncWorker(Napi::Function::New(deferred.Promise().Env(),
-                                        [](const Napi::CallbackInfo &) {})),
-        deferred_(deferred),
-        client_(client) {}
-  ~AsyncDiscardAllWorker() = default;
+  explicit DiscardAllCommand(const Napi::Promise::Deferred &deferred)
+      : Command(deferred) {}
 
-  void Execute() {
+  void Execute(mg::Client *client) override {
     static const std::string NODEMG_MSG_DISCARD_ALL_FAIL =
         "Failed to discard all data.";
     try {
-      client_->DiscardAll();
+      DiscardRemaining(client);
     } catch (const std::exception &error) {
-      SetError(NODEMG_MSG_DISCARD_ALL_FAIL + error.what());
+      SetError(NODEMG_MSG_DISCARD_ALL_FAIL + " " + error.what());
       return;
     }
   }
+};
 
-  void OnOK() {
-    auto env = deferred_.Env();
-    this->deferred_.Resolve(env.Null());
+Napi::Value Client::DiscardAll(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  return Enqueue(env, std::make_unique<DiscardAllCommand>(
+                          Napi::Promise::Deferred::New(env)));
+}
+
+class FetchOneCommand final : public Command {
+ public:
+  FetchOneCommand(const Napi::Promise::Deferred &deferred,
+                  DecodeOptions options)
+      : Command(deferred), options_(options) {}
+
+  void Execute(mg::Client *client) override {
+    static const std::string NODEMG_MSG_FETCH_ONE_FAIL =
+        "Failed to fetch one record.";
+    try {
+      data_ = NextRecord(client);
+    } catch (const std::exception &error) {
+      SetError(NODEMG_MSG_FETCH_ONE_FAIL + " " + error.what());
+      return;
+    }
+    if (data_) {
+      // The following FetchOne calls are served from the buffer.
+      ReadAhead(client);
+    }
   }
 
-  void OnError(const Napi::Error &e) {
-    this->deferred_.Reject(Napi::Error::New(Env(), e.Message()).Value());
+  Napi::Value OnOK(Napi::Env env) override {
+    if (!data_) {
+      return env.Null();
+    }
+    return ConvertRecord(env, std::move(*data_), options_);
   }
 
  private:
-  Napi::Promise::Deferred deferred_;
-  mg::Client *client_;
+  DecodeOptions options_;
+  std::optional<std::vector<mg::Value>> data_;
 };
 
-Napi::Value Client::DiscardAll(const Napi::CallbackInfo &info) {
-  Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(info.Env());
-  auto wk = new AsyncDiscardAllWorker(deferred, client_.get());
-  wk->Queue();
+// Tops up the read-ahead buffer in the background, while FetchOne keeps
+// taking records from it on the main thread.
+class ReadAheadCommand final : public Command {
+ public:
+  explicit ReadAheadCommand(const Napi::Promise::Deferred &deferred)
+      : Command(deferred) {}
+
+  bool Background() const override { return true; }
+
+  void Execute(mg::Client *client) override { ReadAhead(client); }
+
+  Napi::Value OnOK(Napi::Env env) override {
+    Buffer().SetRefilling(false);
+    return env.Null();
+  }
+};
+
+Napi::Value Client::FetchOne(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  auto options = PrepareDecodeOptions(info, 0);
+  if (!options) {
+    return env.Undefined();
+  }
+  // Nothing else is queued, so the next record is the first one read ahead.
+  auto record = client_ && read_ahead_->Idle()
+                    ? read_ahead_->Pop()
+                    : std::optional<std::vector<mg::Value>>();
+  if (!record) {
+    return Enqueue(env, std::make_unique<FetchOneCommand>(
+                            Napi::Promise::Deferred::New(env), *options));
+  }
+  auto deferred = Napi::Promise::Deferred::New(env);
+  auto start = StatsClock::now();
+  try {
+    deferred.Resolve(ConvertRecord(env, std::move(*record), *options));
+  } catch (const Napi::Error &error) {
+    ++stats_->errors;
+    deferred.Reject(error.Value());
+  }
+  stats_->conversion.Record(ElapsedNanoseconds(start));
+  if (!read_ahead_->Refilling() && !read_ahead_->Ended() &&
+      read_ahead_->Size() <= read_ahead_->Capacity() / 2) {
+    read_ahead_->SetRefilling(true);
+    Enqueue(env, std::make_unique<ReadAheadCommand>(
+                     Napi::Promise::Deferred::New(env)));
+  }
   return deferred.Promise();
 }
 
-class AsyncFetchOneWorker final : public Napi::AsyncWorker {
+class FetchBatchCommand final : public Command {
  public:
-  AsyncFetchOneWorker(const Napi::Promise::Deferred &deferred,
-                      mg::Client *client)
-      : AsyncWorker(Napi::Function::New(deferred.Promise().Env(),
-                                        [](const Napi::CallbackInfo &) {})),
-        deferred_(deferred),
-        client_(client) {}
-  ~AsyncFetchOneWorker() = default;
+  FetchBatchCommand(const Napi::Promise::Deferred &deferred,
+                    uint32_t batch_size, DecodeOptions options)
+      : Command(deferred), batch_size_(batch_size), options_(options) {}
 
-  void Execute() {
-    static const std::string NODEMG_MSG_FETCH_ONE_FAIL =
-        "Failed to fetch one record.";
+  void Execute(mg::Client *client) override {
+    static const std::string NODEMG_MSG_FETCH_BATCH_FAIL =
+        "Failed to fetch a batch of records.";
     try {
-      data_ = client_->FetchOne();
+      data_.reserve(batch_size_);
+      while (data_.size() < batch_size_) {
+        auto record = NextRecord(client);
+        if (!record) {
+          break;
+        }
+        data_.emplace_back(std::move(*record));
+      }
     } catch (const std::exception &error) {
-      SetError(NODEMG_MSG_FETCH_ONE_FAIL + error.what());
+      SetError(NODEMG_MSG_FETCH_BATCH_FAIL + " " + error.what());
       return;
     }
   }
 
-  void OnOK() {
-    auto env = deferred_.Env();
+  Napi::Value OnOK(Napi::Env env) override {
+    // A batch shorter than batch_size_ means the result stream is exhausted.
+    auto output_array_value =
+        MgRecordsToNapiArray(env, std::move(data_), options_);
+    if (!output_array_value) {
+      NODEMG_THROW("Failed to convert fetched data.");
+      return env.Undefined();
+    }
+    return *output_array_value;
+  }
 
-    if (!data_) {
-      this->deferred_.Resolve(env.Null());
+ private:
+  uint32_t batch_size_;
+  DecodeOptions options_;
+  std::vector<std::vector<mg::Value>> data_;
+};
+
+Napi::Value Client::FetchBatch(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    NODEMG_THROW("FetchBatch requires the batch size as a number argument.");
+    return env.Undefined();
+  }
+  auto batch_size = info[0].ToNumber().Uint32Value();
+  if (batch_size == 0) {
+    NODEMG_THROW("The batch size has to be a positive number.");
+    return env.Undefined();
+  }
+  auto options = PrepareDecodeOptions(info, 1);
+  if (!options) {
+    return env.Undefined();
+  }
+
+  return Enqueue(env,
+                 std::make_unique<FetchBatchCommand>(
+                     Napi::Promise::Deferred::New(env), batch_size, *options));
+}
+
+// One result column stored contiguously. Homogeneous integer and float
+// columns are kept as plain C arrays, which are handed over to JS as typed
+// arrays; everything else falls back to the regular value conversion.
+struct Column {
+  enum class Type { Null, Integer, Float, Mixed };
+  Type type{Type::Null};
+  bool has_nulls{false};
+  std::vector<int64_t> integers;
+  std::vector<double> floats;
+  // Bit i is set if the value in row i is not null (LSB first).
+  std::vector<uint8_t> validity;
+  std::vector<mg::Value> values;
+};
+
+template <typename T>
+static Napi::ArrayBuffer VectorToNapiArrayBuffer(Napi::Env env,
+                                                 std::vector<T> &&data) {
+  if (data.empty()) {
+    return Napi::ArrayBuffer::New(env, 0);
+  }
+  // The buffer is wrapped without copying, JS GC releases the vector.
+  auto owned = new std::vector<T>(std::move(data));
+  return Napi::ArrayBuffer::New(
+      env, owned->data(), owned->size() * sizeof(T),
+      [](Napi::Env, void *, std::vector<T> *hint) { delete hint; }, owned);
+}
+
+class FetchColumnsCommand final : public Command {
+ public:
+  FetchColumnsCommand(const Napi::Promise::Deferred &deferred,
+                      DecodeOptions options)
+      : Command(deferred), options_(options) {}
+
+  void Execute(mg::Client *client) override {
+    static const std::string NODEMG_MSG_FETCH_COLUMNS_FAIL =
+        "Failed to fetch all records.";
+    std::optional<std::vector<std::vector<mg::Value>>> records;
+    try {
+      records = RemainingRecords(client);
+    } catch (const std::exception &error) {
+      SetError(NODEMG_MSG_FETCH_COLUMNS_FAIL + " " + error.what());
+      return;
+    }
+    if (!records) {
       return;
     }
+    row_count_ = records->size();
+    // An empty result still has a column per field.
+    columns_.resize(records->empty() ? Buffer().Fields()
+                                     : records->front().size());
+    for (const auto &record : *records) {
+      for (size_t index = 0; index < columns_.size(); ++index) {
+        auto &column = columns_[index];
+        switch (mg_value_get_type(record[index].ptr())) {
+          case MG_VALUE_TYPE_NULL:
+            column.has_nulls = true;
+            break;
+          case MG_VALUE_TYPE_INTEGER:
+            if (column.type == Column::Type::Null) {
+              column.type = Column::Type::Integer;
+            } else if (column.type != Column::Type::Integer) {
+              column.type = Column::Type::Mixed;
+            }
+            break;
+          case MG_VALUE_TYPE_FLOAT:
+            if (column.type == Column::Type::Null) {
+              column.type = Column::Type::Float;
+            } else if (column.type != Column::Type::Float) {
+              column.type = Column::Type::Mixed;
+            }
+            break;
+          default:
+            column.type = Column::Type::Mixed;
+        }
+      }
+    }
 
-    auto array_value = Napi::Array::New(env, data_->size());
-    for (uint32_t index = 0; index < data_->size(); ++index) {
-      auto value = MgValueToNapiValue(env, (*data_)[index].ptr());
-      if (!value) {
-        SetError("Failed to convert fetched data.");
-        return;
+    for (size_t index = 0; index < columns_.size(); ++index) {
+      auto &column = columns_[index];
+      if (column.type == Column::Type::Null) {
+        column.type = Column::Type::Mixed;
+      }
+      if (column.type == Column::Type::Mixed) {
+        column.values.reserve(row_count_);
+        for (auto &record : *records) {
+          column.values.emplace_back(std::move(record[index]));
+        }
+        continue;
+      }
+      if (column.has_nulls) {
+        column.validity.resize((row_count_ + 7) / 8, 0);
+      }
+      if (column.type == Column::Type::Integer) {
+        column.integers.resize(row_count_, 0);
+      } else {
+        column.floats.resize(row_count_, 0.0);
+      }
+      for (size_t row = 0; row < row_count_; ++row) {
+        const auto *value = (*records)[row][index].ptr();
+        if (mg_value_get_type(value) == MG_VALUE_TYPE_NULL) {
+          continue;
+        }
+        if (column.has_nulls) {
+          column.validity[row / 8] |= static_cast<uint8_t>(1u << (row % 8));
+        }
+        if (column.type == Column::Type::Integer) {
+          column.integers[row] = mg_value_integer(value);
+        } else {
+          column.floats[row] = mg_value_float(value);
+        }
+      }
+    }
+  }
+
+  Napi::Value OnOK(Napi::Env env) override {
+    auto output_columns = Napi::Array::New(env, columns_.size());
+    for (uint32_t index = 0; index < columns_.size(); ++index) {
+      auto &column = columns_[index];
+      auto output_column = Napi::Object::New(env);
+      switch (column.type) {
+        case Column::Type::Integer: {
+          auto buffer =
+              VectorToNapiArrayBuffer(env, std::move(column.integers));
+          output_column.Set("type", "integer");
+          output_column.Set("values",
+                            Napi::BigInt64Array::New(env, row_count_, buffer,
+                                                     0, napi_bigint64_array));
+          break;
+        }
+        case Column::Type::Float: {
+          auto buffer = VectorToNapiArrayBuffer(env, std::move(column.floats));
+          output_column.Set("type", "float");
+          output_column.Set("values",
+                            Napi::Float64Array::New(env, row_count_, buffer, 0,
+                                                    napi_float64_array));
+          break;
+        }
+        default: {
+          auto column_values = std::make_shared<std::vector<mg::Value>>(
+              std::move(column.values));
+          DecodeContext ctx(env, options_, column_values);
+          auto values = Napi::Array::New(env, column_values->size());
+          for (uint32_t row = 0; row < column_values->size(); ++row) {
+            auto value = MgValueToNapiValue(ctx, (*column_values)[row].ptr());
+            if (!value) {
+              NODEMG_THROW("Failed to convert fetched data.");
+              return env.Undefined();
+            }
+            values[row] = *value;
+          }
+          output_column.Set("type", "mixed");
+          output_column.Set("values", values);
+        }
       }
-      array_value[index] = *value;
+      if (column.has_nulls && column.type != Column::Type::Mixed) {
+        auto size = column.validity.size();
+        auto buffer = VectorToNapiArrayBuffer(env, std::move(column.validity));
+        output_column.Set(
+            "validity",
+            Napi::Uint8Array::New(env, size, buffer, 0, napi_uint8_array));
+      } else {
+        output_column.Set("validity", env.Null());
+      }
+      output_columns[index] = output_column;
     }
 
-    this->deferred_.Resolve(array_value);
+    auto output = Napi::Object::New(env);
+    output.Set("rowCount", static_cast<double>(row_count_));
+    output.Set("columns", output_columns);
+    return output;
   }
 
-  void OnError(const Napi::Error &e) {
-    this->deferred_.Reject(Napi::Error::New(Env(), e.Message()).Value());
+ private:
+  DecodeOptions options_;
+  size_t row_count_{0};
+  std::vector<Column> columns_;
+};
+
+Napi::Value Client::FetchColumns(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  auto options = PrepareDecodeOptions(info, 0);
+  if (!options) {
+    return env.Undefined();
+  }
+  return Enqueue(env, std::make_unique<FetchColumnsCommand>(
+                          Napi::Promise::Deferred::New(env), *options));
+}
+
+// Fetches all records and serializes them into a flat snapshot on the worker
+// thread. The main thread only copies the bytes into an ArrayBuffer.
+class FetchSnapshotCommand final : public Command {
+ public:
+  FetchSnapshotCommand(const Napi::Promise::Deferred &deferred,
+                       std::shared_ptr<ArenaPool> arenas)
+      : Command(deferred), arenas_(std::move(arenas)) {}
+
+  ~FetchSnapshotCommand() override {
+    if (data_) {
+      arenas_->Release(std::move(*data_));
+    }
+  }
+
+  void Execute(mg::Client *client) override {
+    static const std::string NODEMG_MSG_FETCH_SNAPSHOT_FAIL =
+        "Failed to fetch the result snapshot.";
+    try {
+      auto records = RemainingRecords(client);
+      if (!records) {
+        return;
+      }
+      data_ = SnapshotWriter(arenas_->Acquire()).Write(*records);
+    } catch (const std::exception &error) {
+      SetError(NODEMG_MSG_FETCH_SNAPSHOT_FAIL + " " + error.what());
+      return;
+    }
+  }
+
+  Napi::Value OnOK(Napi::Env env) override {
+    if (!data_) {
+      return env.Null();
+    }
+    // Copied instead of wrapped, because only ArrayBuffers allocated by V8
+    // can be transferred to a worker_thread.
+    auto buffer = Napi::ArrayBuffer::New(env, data_->size());
+    std::memcpy(buffer.Data(), data_->data(), data_->size());
+    return buffer;
   }
 
  private:
-  Napi::Promise::Deferred deferred_;
-  mg::Client *client_;
-  decltype(client_->FetchOne()) data_;
+  std::shared_ptr<ArenaPool> arenas_;
+  std::optional<std::vector<uint8_t>> data_;
 };
 
-Napi::Value Client::FetchOne(const Napi::CallbackInfo &info) {
-  Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(info.Env());
-  auto wk = new AsyncFetchOneWorker(deferred, client_.get());
-  wk->Queue();
-  return deferred.Promise();
+Napi::Value Client::FetchSnapshot(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  return Enqueue(env, std::make_unique<FetchSnapshotCommand>(
+                          Napi::Promise::Deferred::New(env), arenas_));
 }
 
-class AsyncTxOpWoker final : public Napi::AsyncWorker {
+class TxOpCommand final : public Command {
  public:
-  AsyncTxOpWoker(const Napi::Promise::Deferred &deferred, mg::Client *client,
-                 Client::TxOp tx_op)
-      : AsyncWorker(Napi::Function::New(deferred.Promise().Env(),
-                                        [](const Napi::CallbackInfo &) {})),
-        deferred_(deferred),
-        client_(client),
-        tx_op_(tx_op) {}
-  ~AsyncTxOpWoker() = default;
+  TxOpCommand(const Napi::Promise::Deferred &deferred, Client::TxOp tx_op)
+      : Command(deferred), tx_op_(tx_op) {}
 
-  void Execute() {
+  void Execute(mg::Client *client) override {
+    ResetReadAhead();
     try {
       switch (tx_op_) {
         case Client::TxOp::Begin: {
-          auto status = client_->BeginTransaction();
+          auto status = client->BeginTransaction();
           if (!status) {
             SetError("Fail to BEGIN transaction.");
             return;
@@ -524,7 +1688,7 @@ class AsyncTxOpWoker final : public Napi::AsyncWorker {
           break;
         }
         case Client::TxOp::Commit: {
-          auto status = client_->CommitTransaction();
+          auto status = client->CommitTransaction();
           if (!status) {
             SetError("Fail to COMMIT transaction.");
             return;
@@ -532,7 +1696,7 @@ class AsyncTxOpWoker final : public Napi::AsyncWorker {
           break;
         }
         case Client::TxOp::Rollback: {
-          auto status = client_->RollbackTransaction();
+          auto status = client->RollbackTransaction();
           if (!status) {
             SetError("Fail to ROLLBACK transaction.");
             return;
@@ -550,40 +1714,29 @@ class AsyncTxOpWoker final : public Napi::AsyncWorker {
     }
   }
 
-  void OnOK() {
-    auto env = deferred_.Env();
-    this->deferred_.Resolve(env.Null());
-  }
-
-  void OnError(const Napi::Error &e) {
-    this->deferred_.Reject(Napi::Error::New(Env(), e.Message()).Value());
-  }
-
  private:
-  Napi::Promise::Deferred deferred_;
-  mg::Client *client_;
   Client::TxOp tx_op_;
 };
 
 Napi::Value Client::Begin(const Napi::CallbackInfo &info) {
-  Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(info.Env());
-  auto wk = new AsyncTxOpWoker(deferred, client_.get(), Client::TxOp::Begin);
-  wk->Queue();
-  return deferred.Promise();
+  auto env = info.Env();
+  return Enqueue(env, std::make_unique<TxOpCommand>(
+                          Napi::Promise::Deferred::New(env),
+                          Client::TxOp::Begin));
 }
 
 Napi::Value Client::Commit(const Napi::CallbackInfo &info) {
-  Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(info.Env());
-  auto wk = new AsyncTxOpWoker(deferred, client_.get(), Client::TxOp::Commit);
-  wk->Queue();
-  return deferred.Promise();
+  auto env = info.Env();
+  return Enqueue(env, std::make_unique<TxOpCommand>(
+                          Napi::Promise::Deferred::New(env),
+                          Client::TxOp::Commit));
 }
 
 Napi::Value Client::Rollback(const Napi::CallbackInfo &info) {
-  Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(info.Env());
-  auto wk = new AsyncTxOpWoker(deferred, client_.get(), Client::TxOp::Rollback);
-  wk->Queue();
-  return deferred.Promise();
+  auto env = info.Env();
+  return Enqueue(env, std::make_unique<TxOpCommand>(
+                          Napi::Promise::Deferred::New(env),
+                          Client::TxOp::Rollback));
 }
 
 }  // namespace nodemg
@@ -12,15 +12,119 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#pragma once
+
 #include <napi.h>
 
+#include <memory>
 #include <mgclient.hpp>
+#include <optional>
+#include <string>
+#include <vector>
 
-// TODO(gitbuda): Ensure AsyncConnection can't be missused in the concurrent
-// environmnt (multiple threads calling the same object).
+#include "arena.hpp"
+#include "glue.hpp"
+#include "params.hpp"
+#include "read_ahead.hpp"
+#include "stats.hpp"
 
 namespace nodemg {
 
+/// A single operation on the connection. Execute runs on the worker thread,
+/// OnOK runs on the main thread and returns the value the Promise is resolved
+/// with. Commands of a Client are executed one at a time in the order they
+/// were issued.
+class Command {
+ public:
+  explicit Command(const Napi::Promise::Deferred &deferred);
+  virtual ~Command() = default;
+
+  virtual void Execute(mg::Client *client) = 0;
+  virtual Napi::Value OnOK(Napi::Env env);
+
+  const Napi::Promise::Deferred &Deferred() const { return deferred_; }
+  const std::optional<std::string> &Error() const { return error_; }
+  void SetError(const std::string &error) { error_ = error; }
+  StatsClock::time_point Enqueued() const { return enqueued_; }
+  uint64_t Rows() const { return rows_; }
+  uint64_t Bytes() const { return bytes_; }
+
+  /// A background command doesn't hold FetchOne, see ReadAheadBuffer.
+  virtual bool Background() const { return false; }
+  /// Main thread. Called by the Client when the command is enqueued and by
+  /// SettleCommand once its Promise is settled.
+  void Attach(std::shared_ptr<ReadAheadBuffer> read_ahead);
+  void Detach();
+
+ protected:
+  /// Counts the received record into the client stats.
+  void CountRecord(const std::vector<mg::Value> &record);
+
+  // Worker thread. The records fetched ahead come first, then the ones read
+  // from the connection. Throw like the mgclient calls.
+  std::optional<std::vector<mg::Value>> NextRecord(mg::Client *client);
+  std::optional<std::vector<std::vector<mg::Value>>> RemainingRecords(
+      mg::Client *client);
+  void DiscardRemaining(mg::Client *client);
+  /// Fills the read-ahead buffer from the current result. Errors end the
+  /// read-ahead and are thrown to the command which reaches them.
+  void ReadAhead(mg::Client *client);
+  /// A new result replaces the one read ahead.
+  void ResetReadAhead();
+
+  ReadAheadBuffer &Buffer() { return *read_ahead_; }
+
+ private:
+  Napi::Promise::Deferred deferred_;
+  std::optional<std::string> error_;
+  StatsClock::time_point enqueued_;
+  uint64_t rows_{0};
+  uint64_t bytes_{0};
+  std::shared_ptr<ReadAheadBuffer> read_ahead_;
+};
+
+/// Executes the command on the calling worker thread and records its
+/// execution time, rows and bytes. Never throws.
+void RunCommand(mg::Client *mg_client, Command &command, ClientStats &stats);
+
+/// Resolves or rejects the Promise of an executed command and records the
+/// conversion time. Main thread only.
+void SettleCommand(Napi::Env env, Command &command, ClientStats &stats);
+
+/// The query text and parameters executed by a command. The text is shared
+/// with the Statement it was prepared by. The parameters map is built from
+/// the snapshot on the worker thread.
+struct Query {
+  std::shared_ptr<const std::string> text;
+  ParamSnapshot params;
+};
+
+/// Converts the user provided connect object into mgclient parameters. An
+/// empty or undefined input results in the default parameters. Throws a JS
+/// error and returns std::nullopt on invalid input.
+std::optional<mg::Client::Params> NapiObjectToMgClientParams(
+    Napi::Env env, Napi::Value input, const std::string &user_agent);
+
+/// Converts the user provided options object into DecodeOptions. Options
+/// which aren't given keep the value from defaults. Throws a JS error and
+/// returns std::nullopt on invalid input.
+std::optional<DecodeOptions> NapiObjectToDecodeOptions(
+    Napi::Env env, Napi::Value input, const DecodeOptions &defaults);
+
+/// Connect arguments which configure the Client instead of the connection.
+struct ClientSettings {
+  /// Execute the commands on a dedicated thread, see IoThread.
+  bool io_thread{false};
+  /// The number of records FetchOne fetches ahead, see ReadAheadBuffer.
+  uint32_t read_ahead{256};
+};
+
+/// Reads the `io_thread` and `read_ahead` connect arguments. The input has
+/// to be validated by NapiObjectToMgClientParams first.
+ClientSettings NapiObjectToClientSettings(Napi::Value input);
+
+class IoThread;
+
 class Client final : public Napi::ObjectWrap<Client> {
  public:
   static Napi::FunctionReference constructor;
@@ -29,28 +133,74 @@ class Client final : public Napi::ObjectWrap<Client> {
 
   Client(const Napi::CallbackInfo &info);
   ~Client();
-  // Public because it's called from AsyncWorker.
+  // Public because they are called from AsyncWorker.
   void SetMgClient(std::unique_ptr<mg::Client> client);
+  void OnCommandsDone();
+  /// Applies the settings of the connect arguments. Has to be called before
+  /// the first command.
+  void Configure(Napi::Env env, const ClientSettings &settings);
 
   enum class TxOp { Begin, Commit, Rollback };
+  // What is done with the result of an executed query.
+  enum class ResultMode { Keep, FetchAll, DiscardAll };
+
+  /// Enqueues the query and returns its Promise. Used by Statement as well.
+  Napi::Value EnqueueQuery(Napi::Env env, Query query, ResultMode mode,
+                           const DecodeOptions &options);
+  /// Reads the options from info[index] on top of the client options.
+  std::optional<DecodeOptions> PrepareDecodeOptions(
+      const Napi::CallbackInfo &info, size_t index);
+  const std::shared_ptr<ArenaPool> &Arenas() const { return arenas_; }
+  const std::shared_ptr<ClientStats> &Metrics() const { return stats_; }
 
   Napi::Value Connect(const Napi::CallbackInfo &info);
   Napi::Value Execute(const Napi::CallbackInfo &info);
   Napi::Value FetchAll(const Napi::CallbackInfo &info);
   Napi::Value DiscardAll(const Napi::CallbackInfo &info);
   Napi::Value FetchOne(const Napi::CallbackInfo &info);
+  Napi::Value FetchBatch(const Napi::CallbackInfo &info);
+  Napi::Value FetchColumns(const Napi::CallbackInfo &info);
+  Napi::Value FetchSnapshot(const Napi::CallbackInfo &info);
+  Napi::Value ExecuteAndFetchAll(const Napi::CallbackInfo &info);
+  Napi::Value ExecuteAndDiscardAll(const Napi::CallbackInfo &info);
+  Napi::Value ExecuteMany(const Napi::CallbackInfo &info);
+  Napi::Value Prepare(const Napi::CallbackInfo &info);
   Napi::Value Begin(const Napi::CallbackInfo &info);
   Napi::Value Commit(const Napi::CallbackInfo &info);
   Napi::Value Rollback(const Napi::CallbackInfo &info);
+  Napi::Value SetOptions(const Napi::CallbackInfo &info);
+  Napi::Value Stats(const Napi::CallbackInfo &info);
+  Napi::Value ResetStats(const Napi::CallbackInfo &info);
 
  private:
   std::unique_ptr<mg::Client> client_;
   std::string name_;
+  // Commands issued while another batch is being executed. They are all
+  // executed by the next worker, so back-to-back calls cost one hop.
+  std::vector<std::unique_ptr<Command>> pending_;
+  bool running_;
+  // Used by the fetch calls which don't pass their own options.
+  DecodeOptions decode_options_;
+  // Shared with the queued commands, which may outlive the client.
+  std::shared_ptr<ArenaPool> arenas_;
+  // Shared with the workers, which record from the threadpool.
+  std::shared_ptr<ClientStats> stats_;
+  // Shared with the commands, which consume it before the connection.
+  std::shared_ptr<ReadAheadBuffer> read_ahead_;
+  // Set when the commands are executed on a dedicated thread instead of the
+  // threadpool. Declared last, the thread has to stop before client_ goes.
+  std::unique_ptr<IoThread> io_thread_;
+
+  /// Appends the command to the queue and returns its Promise.
+  Napi::Value Enqueue(Napi::Env env, std::unique_ptr<Command> command);
+  void Flush();
 
   std::optional<mg::Client::Params> PrepareConnect(
       const Napi::CallbackInfo &info);
-  std::optional<std::pair<std::string, mg::ConstMap>> PrepareQuery(
-      const Napi::CallbackInfo &info);
+  std::optional<Query> PrepareQuery(const Napi::CallbackInfo &info);
+  /// Snapshots the query parameters and records the encoding time.
+  std::optional<ParamSnapshot> PrepareParams(Napi::Env env,
+                                             Napi::Object params);
 };
 
 }  // namespace nodemg
@@ -14,10 +14,88 @@
 
 #include "glue.hpp"
 
+#include <limits>
+
+#include "graph.hpp"
 #include "util.hpp"
 
 namespace nodemg {
 
+// The order has to match DecodeContext::Field.
+static const char *const kFieldNames[] = {
+    "objectType",  "id",         "labels",
+    "properties",  "startNodeId", "endNodeId",
+    "edgeType",    "nodes",       "relationships",
+    "days",        "seconds",     "nanoseconds",
+    "date",        "node",        "relationship",
+    "path",        "local_time",  "local_date_time",
+    "duration",
+};
+static_assert(sizeof(kFieldNames) / sizeof(kFieldNames[0]) ==
+                  static_cast<size_t>(DecodeContext::Field::Count),
+              "kFieldNames doesn't match DecodeContext::Field");
+
+// The constant field names are created once per env and kept alive by the
+// persistent Array.
+struct FieldNamesData {
+  Napi::ObjectReference names;
+};
+
+DecodeContext::DecodeContext(Napi::Env env, DecodeOptions options,
+                             std::shared_ptr<const void> owner)
+    : env_(env),
+      options_(options),
+      owner_(std::move(owner)),
+      interned_(Napi::Array::New(env)) {
+  auto data = env.GetInstanceData<FieldNamesData>();
+  if (!data) {
+    data = new FieldNamesData();
+    auto names = Napi::Array::New(env, static_cast<size_t>(Field::Count));
+    for (uint32_t index = 0; index < static_cast<uint32_t>(Field::Count);
+         ++index) {
+      names[index] = Napi::String::New(env, kFieldNames[index]);
+    }
+    data->names = Napi::Persistent(Napi::Object(names));
+    env.SetInstanceData(data);
+  }
+  auto names = data->names.Value();
+  for (uint32_t index = 0; index < static_cast<uint32_t>(Field::Count);
+       ++index) {
+    fields_[index] = names.Get(index);
+  }
+}
+
+Napi::Value IntegerToNapiValue(Napi::Env env, DecodeOptions::Integers mode,
+                               int64_t value) {
+  // Number.MAX_SAFE_INTEGER
+  static constexpr int64_t kMaxSafeInteger = (int64_t{1} << 53) - 1;
+  switch (mode) {
+    case DecodeOptions::Integers::Number:
+      return Napi::Number::New(env, static_cast<double>(value));
+    case DecodeOptions::Integers::Auto:
+      if (value >= -kMaxSafeInteger && value <= kMaxSafeInteger) {
+        return Napi::Number::New(env, static_cast<double>(value));
+      }
+      return Napi::BigInt::New(env, value);
+    default:
+      return Napi::BigInt::New(env, value);
+  }
+}
+
+Napi::Value DecodeContext::Intern(const mg_string *input_string) {
+  std::string_view key(mg_string_data(input_string),
+                       mg_string_size(input_string));
+  auto it = interned_index_.find(key);
+  if (it != interned_index_.end()) {
+    return interned_.Get(it->second);
+  }
+  auto output_string = Napi::String::New(env_, key.data(), key.size());
+  auto index = interned_.Length();
+  interned_[index] = output_string;
+  interned_index_.emplace(key, index);
+  return output_string;
+}
+
 Napi::Value MgStringToNapiString(Napi::Env env, const mg_string *input_string) {
   Napi::EscapableHandleScope scope(env);
   Napi::Value output_string = Napi::String::New(
@@ -25,61 +103,112 @@ Napi::Value MgStringToNapiString(Napi::Env env, const mg_string *input_string) {
   return scope.Escape(napi_value(output_string));
 }
 
-Napi::Value MgDateToNapiDate(Napi::Env env, const mg_date *input) {
+Napi::Value MgDateToNapiDate(DecodeContext &ctx, const mg_date *input) {
+  auto env = ctx.Env();
   Napi::EscapableHandleScope scope(env);
   Napi::Object output = Napi::Object::New(env);
   auto days = mg_date_days(input);
-  output.Set("objectType", "date");
-  output.Set("days", Napi::BigInt::New(env, days));
-  output.Set("date", Napi::Date::New(env, days * 24 * 60 * 60 * 1000));
+  // The "date" string is both the object type and the field name.
+  output.Set(ctx[DecodeContext::Field::ObjectType],
+             ctx[DecodeContext::Field::Date]);
+  output.Set(ctx[DecodeContext::Field::Days], ctx.Integer(days));
+  output.Set(ctx[DecodeContext::Field::Date],
+             Napi::Date::New(env, days * 24 * 60 * 60 * 1000));
   return scope.Escape(napi_value(output));
 }
 
-Napi::Value MgLocalTimeToNapiLocalTime(Napi::Env env,
+Napi::Value MgLocalTimeToNapiLocalTime(DecodeContext &ctx,
                                        const mg_local_time *input) {
+  auto env = ctx.Env();
   Napi::EscapableHandleScope scope(env);
   auto nanoseconds = mg_local_time_nanoseconds(input);
   Napi::Object output = Napi::Object::New(env);
-  output.Set("objectType", "local_time");
-  output.Set("nanoseconds", Napi::BigInt::New(env, nanoseconds));
+  output.Set(ctx[DecodeContext::Field::ObjectType],
+             ctx[DecodeContext::Field::LocalTimeType]);
+  output.Set(ctx[DecodeContext::Field::Nanoseconds], ctx.Integer(nanoseconds));
   return scope.Escape(napi_value(output));
 }
 
-Napi::Value MgLocalDateTimeToNapiDate(Napi::Env env,
+Napi::Value MgLocalDateTimeToNapiDate(DecodeContext &ctx,
                                       const mg_local_date_time *input) {
+  auto env = ctx.Env();
   Napi::EscapableHandleScope scope(env);
   auto seconds = mg_local_date_time_seconds(input);
   auto nanoseconds = mg_local_date_time_nanoseconds(input);
   // NOTE: An obvious loss of precision (nanoseconds to milliseconds).
   auto milliseconds = 1.0 * (seconds * 1000 + nanoseconds / 10000000);
   Napi::Object output = Napi::Object::New(env);
-  output.Set("objectType", "local_date_time");
-  output.Set("seconds", Napi::BigInt::New(env, seconds));
-  output.Set("nanoseconds", Napi::BigInt::New(env, nanoseconds));
-  output.Set("date", Napi::Date::New(env, milliseconds));
+  output.Set(ctx[DecodeContext::Field::ObjectType],
+             ctx[DecodeContext::Field::LocalDateTimeType]);
+  output.Set(ctx[DecodeContext::Field::Seconds], ctx.Integer(seconds));
+  output.Set(ctx[DecodeContext::Field::Nanoseconds], ctx.Integer(nanoseconds));
+  output.Set(ctx[DecodeContext::Field::Date],
+             Napi::Date::New(env, milliseconds));
   return scope.Escape(napi_value(output));
 }
 
-Napi::Value MgDurationToNapiDuration(Napi::Env env, const mg_duration *input) {
+Napi::Value MgDurationToNapiDuration(DecodeContext &ctx,
+                                     const mg_duration *input) {
+  auto env = ctx.Env();
   Napi::EscapableHandleScope scope(env);
   auto days = mg_duration_days(input);
   auto seconds = mg_duration_seconds(input);
   auto nanoseconds = mg_duration_nanoseconds(input);
   Napi::Object output = Napi::Object::New(env);
-  output.Set("objectType", "duration");
-  output.Set("days", Napi::BigInt::New(env, days));
-  output.Set("seconds", Napi::BigInt::New(env, seconds));
-  output.Set("nanoseconds", Napi::BigInt::New(env, nanoseconds));
+  output.Set(ctx[DecodeContext::Field::ObjectType],
+             ctx[DecodeContext::Field::DurationType]);
+  output.Set(ctx[DecodeContext::Field::Days], ctx.Integer(days));
+  output.Set(ctx[DecodeContext::Field::Seconds], ctx.Integer(seconds));
+  output.Set(ctx[DecodeContext::Field::Nanoseconds], ctx.Integer(nanoseconds));
   return scope.Escape(napi_value(output));
 }
 
-std::optional<Napi::Value> MgListToNapiArray(Napi::Env env,
+// Returns the element type if all elements of the non-empty list are either
+// integers or floats.
+static std::optional<mg_value_type> NumericListType(const mg_list *input_list) {
+  auto input_list_size = mg_list_size(input_list);
+  if (input_list_size == 0) {
+    return std::nullopt;
+  }
+  auto type = mg_value_get_type(mg_list_at(input_list, 0));
+  if (type != MG_VALUE_TYPE_INTEGER && type != MG_VALUE_TYPE_FLOAT) {
+    return std::nullopt;
+  }
+  for (uint32_t index = 1; index < input_list_size; ++index) {
+    if (mg_value_get_type(mg_list_at(input_list, index)) != type) {
+      return std::nullopt;
+    }
+  }
+  return type;
+}
+
+std::optional<Napi::Value> MgListToNapiArray(DecodeContext &ctx,
                                              const mg_list *input_list) {
+  auto env = ctx.Env();
   Napi::EscapableHandleScope scope(env);
   auto input_list_size = mg_list_size(input_list);
+  if (ctx.Options().typed_lists) {
+    auto type = NumericListType(input_list);
+    if (type == MG_VALUE_TYPE_FLOAT) {
+      auto output_array = Napi::Float64Array::New(env, input_list_size);
+      auto data = output_array.Data();
+      for (uint32_t index = 0; index < input_list_size; ++index) {
+        data[index] = mg_value_float(mg_list_at(input_list, index));
+      }
+      return scope.Escape(output_array);
+    }
+    if (type == MG_VALUE_TYPE_INTEGER) {
+      auto output_array = Napi::BigInt64Array::New(env, input_list_size);
+      auto data = output_array.Data();
+      for (uint32_t index = 0; index < input_list_size; ++index) {
+        data[index] = mg_value_integer(mg_list_at(input_list, index));
+      }
+      return scope.Escape(output_array);
+    }
+  }
   auto output_array = Napi::Array::New(env, input_list_size);
   for (uint32_t index = 0; index < input_list_size; ++index) {
-    auto value = MgValueToNapiValue(env, mg_list_at(input_list, index));
+    auto value = MgValueToNapiValue(ctx, mg_list_at(input_list, index));
     if (!value) {
       return std::nullopt;
     }
@@ -88,13 +217,20 @@ std::optional<Napi::Value> MgListToNapiArray(Napi::Env env,
   return scope.Escape(output_array);
 }
 
-std::optional<Napi::Value> MgMapToNapiObject(Napi::Env env,
+std::optional<Napi::Value> MgListToNapiArray(Napi::Env env,
+                                             const mg_list *input_list) {
+  DecodeContext ctx(env);
+  return MgListToNapiArray(ctx, input_list);
+}
+
+std::optional<Napi::Value> MgMapToNapiObject(DecodeContext &ctx,
                                              const mg_map *input_map) {
+  auto env = ctx.Env();
   Napi::EscapableHandleScope scope(env);
   Napi::Object output_object = Napi::Object::New(env);
   for (uint32_t i = 0; i < mg_map_size(input_map); ++i) {
-    auto key = MgStringToNapiString(env, mg_map_key_at(input_map, i));
-    auto value = MgValueToNapiValue(env, mg_map_value_at(input_map, i));
+    auto key = ctx.Intern(mg_map_key_at(input_map, i));
+    auto value = MgValueToNapiValue(ctx, mg_map_value_at(input_map, i));
     if (!value) {
       return std::nullopt;
     }
@@ -103,92 +239,112 @@ std::optional<Napi::Value> MgMapToNapiObject(Napi::Env env,
   return scope.Escape(napi_value(output_object));
 }
 
-std::optional<Napi::Value> MgNodeToNapiNode(Napi::Env env,
+std::optional<Napi::Value> MgMapToNapiObject(Napi::Env env,
+                                             const mg_map *input_map) {
+  DecodeContext ctx(env);
+  return MgMapToNapiObject(ctx, input_map);
+}
+
+std::optional<Napi::Value> MgNodeToNapiNode(DecodeContext &ctx,
                                             const mg_node *input_node) {
+  auto env = ctx.Env();
   Napi::EscapableHandleScope scope(env);
-  auto node_id = Napi::BigInt::New(env, mg_node_id(input_node));
+  auto node_id = ctx.Integer(mg_node_id(input_node));
 
   auto label_count = mg_node_label_count(input_node);
   auto node_labels = Napi::Array::New(env, label_count);
   for (uint32_t label_index = 0; label_index < label_count; ++label_index) {
-    auto label =
-        MgStringToNapiString(env, mg_node_label_at(input_node, label_index));
-    node_labels[label_index] = label;
+    node_labels[label_index] =
+        ctx.Intern(mg_node_label_at(input_node, label_index));
   }
 
-  auto node_properties = MgMapToNapiObject(env, mg_node_properties(input_node));
+  auto node_properties = MgMapToNapiObject(ctx, mg_node_properties(input_node));
   if (!node_properties) {
     return std::nullopt;
   }
 
   Napi::Object output_node = Napi::Object::New(env);
-  output_node.Set("objectType", "node");
-  output_node.Set("id", node_id);
-  output_node.Set("labels", node_labels);
-  output_node.Set("properties", *node_properties);
+  output_node.Set(ctx[DecodeContext::Field::ObjectType],
+                  ctx[DecodeContext::Field::NodeType]);
+  output_node.Set(ctx[DecodeContext::Field::Id], node_id);
+  output_node.Set(ctx[DecodeContext::Field::Labels], node_labels);
+  output_node.Set(ctx[DecodeContext::Field::Properties], *node_properties);
   return scope.Escape(napi_value(output_node));
 }
 
 std::optional<Napi::Value> MgRelationshipToNapiRelationship(
-    Napi::Env env, const mg_relationship *input_relationship) {
+    DecodeContext &ctx, const mg_relationship *input_relationship) {
+  auto env = ctx.Env();
   Napi::EscapableHandleScope scope(env);
 
-  auto relationship_id =
-      Napi::BigInt::New(env, mg_relationship_id(input_relationship));
+  auto relationship_id = ctx.Integer(mg_relationship_id(input_relationship));
   auto relationship_start_node_id =
-      Napi::BigInt::New(env, mg_relationship_start_id(input_relationship));
+      ctx.Integer(mg_relationship_start_id(input_relationship));
   auto relationship_end_node_id =
-      Napi::BigInt::New(env, mg_relationship_end_id(input_relationship));
+      ctx.Integer(mg_relationship_end_id(input_relationship));
 
   auto relationship_type =
-      MgStringToNapiString(env, mg_relationship_type(input_relationship));
+      ctx.Intern(mg_relationship_type(input_relationship));
 
   auto relationship_properties =
-      MgMapToNapiObject(env, mg_relationship_properties(input_relationship));
+      MgMapToNapiObject(ctx, mg_relationship_properties(input_relationship));
   if (!relationship_properties) {
     return std::nullopt;
   }
 
   Napi::Object output_relationship = Napi::Object::New(env);
-  output_relationship.Set("objectType", "relationship");
-  output_relationship.Set("id", relationship_id);
-  output_relationship.Set("startNodeId", relationship_start_node_id);
-  output_relationship.Set("endNodeId", relationship_end_node_id);
-  output_relationship.Set("edgeType", relationship_type);
-  output_relationship.Set("properties", *relationship_properties);
+  output_relationship.Set(ctx[DecodeContext::Field::ObjectType],
+                          ctx[DecodeContext::Field::RelationshipType]);
+  output_relationship.Set(ctx[DecodeContext::Field::Id], relationship_id);
+  output_relationship.Set(ctx[DecodeContext::Field::StartNodeId],
+                          relationship_start_node_id);
+  output_relationship.Set(ctx[DecodeContext::Field::EndNodeId],
+                          relationship_end_node_id);
+  output_relationship.Set(ctx[DecodeContext::Field::EdgeType],
+                          relationship_type);
+  output_relationship.Set(ctx[DecodeContext::Field::Properties],
+                          *relationship_properties);
   return scope.Escape(napi_value(output_relationship));
 }
 
 std::optional<Napi::Value> MgUnboundRelationshipToNapiRelationship(
-    Napi::Env env, const mg_unbound_relationship *input_unbound_relationship) {
+    DecodeContext &ctx,
+    const mg_unbound_relationship *input_unbound_relationship) {
+  auto env = ctx.Env();
   Napi::EscapableHandleScope scope(env);
 
-  auto relationship_id = Napi::BigInt::New(
-      env, mg_unbound_relationship_id(input_unbound_relationship));
+  auto relationship_id =
+      ctx.Integer(mg_unbound_relationship_id(input_unbound_relationship));
   int64_t relationship_start_node_id = -1;
   int64_t relationship_end_node_id = -1;
 
-  auto relationship_type = MgStringToNapiString(
-      env, mg_unbound_relationship_type(input_unbound_relationship));
+  auto relationship_type =
+      ctx.Intern(mg_unbound_relationship_type(input_unbound_relationship));
 
   auto relationship_properties = MgMapToNapiObject(
-      env, mg_unbound_relationship_properties(input_unbound_relationship));
+      ctx, mg_unbound_relationship_properties(input_unbound_relationship));
   if (!relationship_properties) {
     return std::nullopt;
   }
 
   Napi::Object output_relationship = Napi::Object::New(env);
-  output_relationship.Set("objectType", "relationship");
-  output_relationship.Set("id", relationship_id);
-  output_relationship.Set("startNodeId", relationship_start_node_id);
-  output_relationship.Set("endNodeId", relationship_end_node_id);
-  output_relationship.Set("edgeType", relationship_type);
-  output_relationship.Set("properties", *relationship_properties);
+  output_relationship.Set(ctx[DecodeContext::Field::ObjectType],
+                          ctx[DecodeContext::Field::RelationshipType]);
+  output_relationship.Set(ctx[DecodeContext::Field::Id], relationship_id);
+  output_relationship.Set(ctx[DecodeContext::Field::StartNodeId],
+                          relationship_start_node_id);
+  output_relationship.Set(ctx[DecodeContext::Field::EndNodeId],
+                          relationship_end_node_id);
+  output_relationship.Set(ctx[DecodeContext::Field::EdgeType],
+                          relationship_type);
+  output_relationship.Set(ctx[DecodeContext::Field::Properties],
+                          *relationship_properties);
   return scope.Escape(napi_value(output_relationship));
 }
 
-std::optional<Napi::Value> MgPathToNapiPath(Napi::Env env,
+std::optional<Napi::Value> MgPathToNapiPath(DecodeContext &ctx,
                                             const mg_path *input_path) {
+  auto env = ctx.Env();
   Napi::EscapableHandleScope scope(env);
 
   auto nodes = Napi::Array::New(env);
@@ -196,27 +352,28 @@ std::optional<Napi::Value> MgPathToNapiPath(Napi::Env env,
   int64_t prev_node_id = -1;
   for (uint32_t index = 0; index <= mg_path_length(input_path); ++index) {
     int64_t curr_node_id = mg_node_id(mg_path_node_at(input_path, index));
-    auto node = MgNodeToNapiNode(env, mg_path_node_at(input_path, index));
+    auto node = MgNodeToNapiNode(ctx, mg_path_node_at(input_path, index));
     if (!node) {
       return std::nullopt;
     }
     nodes[index] = *node;
     if (index > 0) {
       auto relationship = MgUnboundRelationshipToNapiRelationship(
-          env, mg_path_relationship_at(input_path, index - 1));
+          ctx, mg_path_relationship_at(input_path, index - 1));
       if (!relationship) {
         return std::nullopt;
       }
+      auto output_relationship = relationship->As<Napi::Object>();
       if (mg_path_relationship_reversed_at(input_path, index - 1)) {
-        relationship->As<Napi::Object>().Set(
-            "startNodeId", Napi::BigInt::New(env, curr_node_id));
-        relationship->As<Napi::Object>().Set(
-            "endNodeId", Napi::BigInt::New(env, prev_node_id));
+        output_relationship.Set(ctx[DecodeContext::Field::StartNodeId],
+                                ctx.Integer(curr_node_id));
+        output_relationship.Set(ctx[DecodeContext::Field::EndNodeId],
+                                ctx.Integer(prev_node_id));
       } else {
-        relationship->As<Napi::Object>().Set(
-            "startNodeId", Napi::BigInt::New(env, prev_node_id));
-        relationship->As<Napi::Object>().Set(
-            "endNodeId", Napi::BigInt::New(env, curr_node_id));
+        output_relationship.Set(ctx[DecodeContext::Field::StartNodeId],
+                                ctx.Integer(prev_node_id));
+        output_relationship.Set(ctx[DecodeContext::Field::EndNodeId],
+                                ctx.Integer(curr_node_id));
       }
       relationships[index - 1] = *relationship;
     }
@@ -224,9 +381,10 @@ std::optional<Napi::Value> MgPathToNapiPath(Napi::Env env,
   }
 
   Napi::Object output_path = Napi::Object::New(env);
-  output_path.Set("objectType", "path");
-  output_path.Set("nodes", nodes);
-  output_path.Set("relationships", relationships);
+  output_path.Set(ctx[DecodeContext::Field::ObjectType],
+                  ctx[DecodeContext::Field::PathType]);
+  output_path.Set(ctx[DecodeContext::Field::Nodes], nodes);
+  output_path.Set(ctx[DecodeContext::Field::Relationships], relationships);
   return scope.Escape(napi_value(output_path));
 }
 
@@ -234,8 +392,9 @@ std::optional<Napi::Value> MgPathToNapiPath(Napi::Env env,
 // during e.g. list construction which doesn't have any error handling inside.
 // Policy has to be created. It probably makes sense to have both because
 // more granular error messages could be presented to the user.
-std::optional<Napi::Value> MgValueToNapiValue(Napi::Env env,
+std::optional<Napi::Value> MgValueToNapiValue(DecodeContext &ctx,
                                               const mg_value *input_value) {
+  auto env = ctx.Env();
   Napi::EscapableHandleScope scope(env);
   switch (mg_value_get_type(input_value)) {
     case MG_VALUE_TYPE_NULL:
@@ -245,7 +404,7 @@ std::optional<Napi::Value> MgValueToNapiValue(Napi::Env env,
           napi_value(Napi::Boolean::New(env, mg_value_bool(input_value))));
     case MG_VALUE_TYPE_INTEGER:
       return scope.Escape(
-          napi_value(Napi::BigInt::New(env, mg_value_integer(input_value))));
+          napi_value(ctx.Integer(mg_value_integer(input_value))));
     case MG_VALUE_TYPE_FLOAT:
       return scope.Escape(
           napi_value(Napi::Number::New(env, mg_value_float(input_value))));
@@ -254,55 +413,85 @@ std::optional<Napi::Value> MgValueToNapiValue(Napi::Env env,
           napi_value(MgStringToNapiString(env, mg_value_string(input_value))));
     case MG_VALUE_TYPE_DATE:
       return scope.Escape(
-          napi_value(MgDateToNapiDate(env, mg_value_date(input_value))));
+          napi_value(MgDateToNapiDate(ctx, mg_value_date(input_value))));
     case MG_VALUE_TYPE_LOCAL_TIME:
       return scope.Escape(napi_value(
-          MgLocalTimeToNapiLocalTime(env, mg_value_local_time(input_value))));
+          MgLocalTimeToNapiLocalTime(ctx, mg_value_local_time(input_value))));
     case MG_VALUE_TYPE_LOCAL_DATE_TIME:
       return scope.Escape(napi_value(MgLocalDateTimeToNapiDate(
-          env, mg_value_local_date_time(input_value))));
+          ctx, mg_value_local_date_time(input_value))));
     case MG_VALUE_TYPE_DURATION:
       return scope.Escape(napi_value(
-          MgDurationToNapiDuration(env, mg_value_duration(input_value))));
+          MgDurationToNapiDuration(ctx, mg_value_duration(input_value))));
     case MG_VALUE_TYPE_LIST: {
-      auto list_value = MgListToNapiArray(env, mg_value_list(input_value));
+      auto list_value = MgListToNapiArray(ctx, mg_value_list(input_value));
       if (!list_value) {
         return std::nullopt;
       }
       return scope.Escape(napi_value(*list_value));
     }
     case MG_VALUE_TYPE_MAP: {
-      auto map_value = MgMapToNapiObject(env, mg_value_map(input_value));
+      auto map_value = MgMapToNapiObject(ctx, mg_value_map(input_value));
       if (!map_value) {
         return std::nullopt;
       }
       return scope.Escape(napi_value(*map_value));
     }
     case MG_VALUE_TYPE_NODE: {
-      auto node_value = MgNodeToNapiNode(env, mg_value_node(input_value));
+      if (ctx.Options().lazy_graph) {
+        auto node = Node::New(ctx, mg_value_node(input_value));
+        if (!node) {
+          return std::nullopt;
+        }
+        return scope.Escape(napi_value(*node));
+      }
+      auto node_value = MgNodeToNapiNode(ctx, mg_value_node(input_value));
       if (!node_value) {
         return std::nullopt;
       }
       return scope.Escape(napi_value(*node_value));
     }
     case MG_VALUE_TYPE_RELATIONSHIP: {
+      if (ctx.Options().lazy_graph) {
+        auto relationship =
+            Relationship::New(ctx, mg_value_relationship(input_value));
+        if (!relationship) {
+          return std::nullopt;
+        }
+        return scope.Escape(napi_value(*relationship));
+      }
       auto relationship_value = MgRelationshipToNapiRelationship(
-          env, mg_value_relationship(input_value));
+          ctx, mg_value_relationship(input_value));
       if (!relationship_value) {
         return std::nullopt;
       }
       return scope.Escape(napi_value(*relationship_value));
     }
     case MG_VALUE_TYPE_UNBOUND_RELATIONSHIP: {
+      if (ctx.Options().lazy_graph) {
+        auto relationship = Relationship::New(
+            ctx, mg_value_unbound_relationship(input_value));
+        if (!relationship) {
+          return std::nullopt;
+        }
+        return scope.Escape(napi_value(*relationship));
+      }
       auto unbound_relationship_value = MgUnboundRelationshipToNapiRelationship(
-          env, mg_value_unbound_relationship(input_value));
+          ctx, mg_value_unbound_relationship(input_value));
       if (!unbound_relationship_value) {
         return std::nullopt;
       }
       return scope.Escape(napi_value(*unbound_relationship_value));
     }
     case MG_VALUE_TYPE_PATH: {
-      auto path_value = MgPathToNapiPath(env, mg_value_path(input_value));
+      if (ctx.Options().lazy_graph) {
+        auto path = Path::New(ctx, mg_value_path(input_value));
+        if (!path) {
+          return std::nullopt;
+        }
+        return scope.Escape(napi_value(*path));
+      }
+      auto path_value = MgPathToNapiPath(ctx, mg_value_path(input_value));
       if (!path_value) {
         return std::nullopt;
       }
@@ -318,6 +507,12 @@ std::optional<Napi::Value> MgValueToNapiValue(Napi::Env env,
   }
 }
 
+std::optional<Napi::Value> MgValueToNapiValue(Napi::Env env,
+                                              const mg_value *input_value) {
+  DecodeContext ctx(env);
+  return MgValueToNapiValue(ctx, input_value);
+}
+
 std::optional<int64_t> GetInt64Value(Napi::Object input,
                                      const std::string &key) {
   if (!input.Has(key)) return std::nullopt;
@@ -387,6 +582,84 @@ std::optional<mg_list *> NapiArrayToMgList(Napi::Env env,
   return output_list;
 }
 
+// Typed arrays are converted by a loop over the backing store, without any
+// N-API call per element.
+template <typename T, typename MakeValue>
+static std::optional<mg_list *> TypedArrayToMgList(
+    Napi::Env env, Napi::TypedArray input_array, MakeValue make_value) {
+  auto size = input_array.ElementLength();
+  if (size > std::numeric_limits<uint32_t>::max()) {
+    NODEMG_THROW("Typed array is too large for a Memgraph list.");
+    return std::nullopt;
+  }
+  const T *data = input_array.As<Napi::TypedArrayOf<T>>().Data();
+  mg_list *output_list = mg_list_make_empty(static_cast<uint32_t>(size));
+  if (!output_list) {
+    NODEMG_THROW("Fail to construct Memgraph list.");
+    return std::nullopt;
+  }
+  for (size_t index = 0; index < size; ++index) {
+    mg_value *value = make_value(data[index]);
+    if (!value) {
+      mg_list_destroy(output_list);
+      NODEMG_THROW("Fail to construct Memgraph value while constructing list.");
+      return std::nullopt;
+    }
+    if (mg_list_append(output_list, value) != 0) {
+      mg_list_destroy(output_list);
+      NODEMG_THROW("Fail to append Memgraph list value.");
+      return std::nullopt;
+    }
+  }
+  return output_list;
+}
+
+// Float arrays become lists of floats and integer arrays lists of integers.
+// NOTE: mgclient has no bytes value, so a Buffer (a Uint8Array) is passed as
+// a list of integers.
+std::optional<mg_list *> NapiTypedArrayToMgList(Napi::Env env,
+                                                Napi::TypedArray input_array) {
+  auto make_integer = [](auto value) {
+    return mg_value_make_integer(static_cast<int64_t>(value));
+  };
+  auto make_float = [](auto value) {
+    return mg_value_make_float(static_cast<double>(value));
+  };
+  switch (input_array.TypedArrayType()) {
+    case napi_int8_array:
+      return TypedArrayToMgList<int8_t>(env, input_array, make_integer);
+    case napi_uint8_array:
+    case napi_uint8_clamped_array:
+      return TypedArrayToMgList<uint8_t>(env, input_array, make_integer);
+    case napi_int16_array:
+      return TypedArrayToMgList<int16_t>(env, input_array, make_integer);
+    case napi_uint16_array:
+      return TypedArrayToMgList<uint16_t>(env, input_array, make_integer);
+    case napi_int32_array:
+      return TypedArrayToMgList<int32_t>(env, input_array, make_integer);
+    case napi_uint32_array:
+      return TypedArrayToMgList<uint32_t>(env, input_array, make_integer);
+    case napi_bigint64_array:
+      return TypedArrayToMgList<int64_t>(env, input_array, make_integer);
+    case napi_biguint64_array:
+      return TypedArrayToMgList<uint64_t>(
+          env, input_array, [](uint64_t value) -> mg_value * {
+            if (value > static_cast<uint64_t>(
+                            std::numeric_limits<int64_t>::max())) {
+              return nullptr;
+            }
+            return mg_value_make_integer(static_cast<int64_t>(value));
+          });
+    case napi_float32_array:
+      return TypedArrayToMgList<float>(env, input_array, make_float);
+    case napi_float64_array:
+      return TypedArrayToMgList<double>(env, input_array, make_float);
+    default:
+      NODEMG_THROW("Unsupported typed array type.");
+      return std::nullopt;
+  }
+}
+
 std::optional<mg_value *> NapiValueToMgValue(Napi::Env env,
                                              Napi::Value input_value) {
   mg_value *output_value = nullptr;
@@ -408,7 +681,7 @@ std::optional<mg_value *> NapiValueToMgValue(Napi::Env env,
     output_value = mg_value_make_float(as_double);
   } else if (input_value.IsString()) {
     mg_string *input_mg_string =
-        mg_string_make(input_value.As<Napi::String>().Utf8Value().c_str());
+        NapiStringToMgString(input_value.As<Napi::String>());
     if (!input_mg_string) {
       NODEMG_THROW("Fail to construct Memgraph string.");
       return std::nullopt;
@@ -420,6 +693,13 @@ std::optional<mg_value *> NapiValueToMgValue(Napi::Env env,
       return std::nullopt;
     }
     output_value = mg_value_make_list(*maybe_mg_list);
+  } else if (input_value.IsTypedArray()) {
+    auto maybe_mg_list =
+        NapiTypedArrayToMgList(env, input_value.As<Napi::TypedArray>());
+    if (!maybe_mg_list) {
+      return std::nullopt;
+    }
+    output_value = mg_value_make_list(*maybe_mg_list);
     // NOTE: The "dispatch" below could be implemented in a much better way
     // (probably the whole function as well), but that's a nice exercise for the
     // future.
@@ -482,6 +762,11 @@ std::optional<mg_value *> NapiValueToMgValue(Napi::Env env,
   return output_value;
 }
 
+mg_string *NapiStringToMgString(const Napi::String &input_string) {
+  auto value = input_string.Utf8Value();
+  return mg_string_make2(static_cast<uint32_t>(value.size()), value.data());
+}
+
 std::optional<mg_map *> NapiObjectToMgMap(Napi::Env env,
                                           Napi::Object input_object) {
   mg_map *output_map = nullptr;
@@ -494,8 +779,7 @@ std::optional<mg_map *> NapiObjectToMgMap(Napi::Env env,
   }
   for (uint32_t index = 0; index < keys.Length(); index++) {
     Napi::Value napi_key = keys[index];
-    mg_string *mg_key =
-        mg_string_make(napi_key.As<Napi::String>().Utf8Value().c_str());
+    mg_string *mg_key = NapiStringToMgString(napi_key.As<Napi::String>());
     if (!mg_key) {
       mg_map_destroy(output_map);
       NODEMG_THROW("Fail to constract Memgraph string while creating map.");
@@ -503,6 +787,7 @@ std::optional<mg_map *> NapiObjectToMgMap(Napi::Env env,
     }
     auto maybe_mg_value = NapiValueToMgValue(env, input_object.Get(napi_key));
     if (!maybe_mg_value) {
+      mg_string_destroy(mg_key);
       mg_map_destroy(output_map);
       return std::nullopt;
     }
@@ -515,4 +800,83 @@ std::optional<mg_map *> NapiObjectToMgMap(Napi::Env env,
   return output_map;
 }
 
+static uint64_t StringBytes(const mg_string *value) {
+  return mg_string_size(value);
+}
+
+static uint64_t NodeBytes(const mg_node *value) {
+  uint64_t bytes = sizeof(int64_t);
+  for (uint32_t index = 0; index < mg_node_label_count(value); ++index) {
+    bytes += StringBytes(mg_node_label_at(value, index));
+  }
+  return bytes + MgMapPayloadBytes(mg_node_properties(value));
+}
+
+static uint64_t UnboundRelationshipBytes(
+    const mg_unbound_relationship *value) {
+  return sizeof(int64_t) + StringBytes(mg_unbound_relationship_type(value)) +
+         MgMapPayloadBytes(mg_unbound_relationship_properties(value));
+}
+
+uint64_t MgValuePayloadBytes(const mg_value *value) {
+  switch (mg_value_get_type(value)) {
+    case MG_VALUE_TYPE_NULL:
+    case MG_VALUE_TYPE_BOOL:
+      return 1;
+    case MG_VALUE_TYPE_INTEGER:
+    case MG_VALUE_TYPE_FLOAT:
+    case MG_VALUE_TYPE_DATE:
+    case MG_VALUE_TYPE_LOCAL_TIME:
+      return sizeof(int64_t);
+    case MG_VALUE_TYPE_LOCAL_DATE_TIME:
+      return 2 * sizeof(int64_t);
+    case MG_VALUE_TYPE_DURATION:
+      return 3 * sizeof(int64_t);
+    case MG_VALUE_TYPE_STRING:
+      return StringBytes(mg_value_string(value));
+    case MG_VALUE_TYPE_LIST: {
+      const auto *list = mg_value_list(value);
+      uint64_t bytes = 0;
+      for (uint32_t index = 0; index < mg_list_size(list); ++index) {
+        bytes += MgValuePayloadBytes(mg_list_at(list, index));
+      }
+      return bytes;
+    }
+    case MG_VALUE_TYPE_MAP:
+      return MgMapPayloadBytes(mg_value_map(value));
+    case MG_VALUE_TYPE_NODE:
+      return NodeBytes(mg_value_node(value));
+    case MG_VALUE_TYPE_RELATIONSHIP: {
+      const auto *relationship = mg_value_relationship(value);
+      return 3 * sizeof(int64_t) +
+             StringBytes(mg_relationship_type(relationship)) +
+             MgMapPayloadBytes(mg_relationship_properties(relationship));
+    }
+    case MG_VALUE_TYPE_UNBOUND_RELATIONSHIP:
+      return UnboundRelationshipBytes(mg_value_unbound_relationship(value));
+    case MG_VALUE_TYPE_PATH: {
+      const auto *path = mg_value_path(value);
+      uint64_t bytes = 0;
+      for (uint32_t index = 0; index <= mg_path_length(path); ++index) {
+        bytes += NodeBytes(mg_path_node_at(path, index));
+      }
+      for (uint32_t index = 0; index < mg_path_length(path); ++index) {
+        bytes += UnboundRelationshipBytes(mg_path_relationship_at(path, index));
+      }
+      return bytes;
+    }
+    default:
+      return 0;
+  }
+}
+
+uint64_t MgMapPayloadBytes(const mg_map *value) {
+  uint64_t bytes = 0;
+  for (uint32_t index = 0; index < mg_map_size(value); ++index) {
+    bytes += StringBytes(mg_map_key_at(value, index)) +
+             MgValuePayloadBytes(mg_map_value_at(value, index));
+  }
+  return bytes;
+}
+
 }  // namespace nodemg
@@ -12,26 +12,161 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#pragma once
+
 #include <mgclient.h>
 #include <napi.h>
 
+#include <chrono>
+#include <memory>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 
 namespace nodemg {
 
+struct MgDeleter {
+  void operator()(mg_value *value) const { mg_value_destroy(value); }
+  void operator()(mg_list *value) const { mg_list_destroy(value); }
+  void operator()(mg_map *value) const { mg_map_destroy(value); }
+  void operator()(mg_string *value) const { mg_string_destroy(value); }
+};
+using MgValuePtr = std::unique_ptr<mg_value, MgDeleter>;
+using MgListPtr = std::unique_ptr<mg_list, MgDeleter>;
+using MgMapPtr = std::unique_ptr<mg_map, MgDeleter>;
+using MgStringPtr = std::unique_ptr<mg_string, MgDeleter>;
+
+/// Controls how mg_values are converted into JS values.
+struct DecodeOptions {
+  /// How integers, ids and temporal fields are returned. Number loses
+  /// precision beyond 2^53, Auto returns a BigInt only for such values.
+  enum class Integers { BigInt, Number, Auto };
+  Integers integers{Integers::BigInt};
+  /// Nodes, relationships and paths are returned as native-backed objects
+  /// which convert their content only once it's accessed.
+  bool lazy_graph{false};
+  /// Non-empty lists of only floats or only integers are returned as
+  /// Float64Array or BigInt64Array.
+  bool typed_lists{false};
+  /// FetchAll and ExecuteAndFetchAll convert the records in slices of about
+  /// this duration and yield to the event loop in between. Zero converts
+  /// the whole result at once.
+  std::chrono::microseconds time_slice{0};
+};
+
+Napi::Value IntegerToNapiValue(Napi::Env env, DecodeOptions::Integers mode,
+                               int64_t value);
+
+/// State shared by all values converted from one result. Property keys,
+/// labels and edge types repeat on every row, so the JS strings created for
+/// them are reused, and the constant field names are created once per env.
+/// Has to live within a single handle scope.
+class DecodeContext {
+ public:
+  enum class Field : uint32_t {
+    ObjectType,
+    Id,
+    Labels,
+    Properties,
+    StartNodeId,
+    EndNodeId,
+    EdgeType,
+    Nodes,
+    Relationships,
+    Days,
+    Seconds,
+    Nanoseconds,
+    Date,
+    NodeType,
+    RelationshipType,
+    PathType,
+    LocalTimeType,
+    LocalDateTimeType,
+    DurationType,
+    Count,
+  };
+
+  /// The owner keeps the converted mg_values alive. It's only required by
+  /// the lazy conversion, which references the values after the conversion
+  /// is done; without an owner the lazy objects copy what they reference.
+  explicit DecodeContext(Napi::Env env, DecodeOptions options = {},
+                         std::shared_ptr<const void> owner = nullptr);
+
+  Napi::Env Env() const { return env_; }
+  const DecodeOptions &Options() const { return options_; }
+  const std::shared_ptr<const void> &Owner() const { return owner_; }
+  Napi::Value Integer(int64_t value) const {
+    return IntegerToNapiValue(env_, options_.integers, value);
+  }
+  napi_value operator[](Field field) const {
+    return fields_[static_cast<uint32_t>(field)];
+  }
+  /// Returns the JS string equal to the given mg_string, created only on the
+  /// first call. The mg_string has to outlive the context.
+  Napi::Value Intern(const mg_string *input_string);
+
+ private:
+  Napi::Env env_;
+  DecodeOptions options_;
+  std::shared_ptr<const void> owner_;
+  napi_value fields_[static_cast<uint32_t>(Field::Count)];
+  // Interned strings are stored in the Array because a napi_value created
+  // inside a nested handle scope isn't valid once that scope is closed.
+  Napi::Array interned_;
+  std::unordered_map<std::string_view, uint32_t> interned_index_;
+};
+
+[[nodiscard]] std::optional<Napi::Value> MgValueToNapiValue(
+    DecodeContext &ctx, const mg_value *input_value);
+
 [[nodiscard]] std::optional<Napi::Value> MgValueToNapiValue(
     Napi::Env env, const mg_value *input_value);
 
+[[nodiscard]] std::optional<Napi::Value> MgListToNapiArray(
+    DecodeContext &ctx, const mg_list *input_list);
+
 [[nodiscard]] std::optional<Napi::Value> MgListToNapiArray(
     Napi::Env env, const mg_list *input_list);
 
+[[nodiscard]] std::optional<Napi::Value> MgMapToNapiObject(
+    DecodeContext &ctx, const mg_map *input_map);
+
 [[nodiscard]] std::optional<Napi::Value> MgMapToNapiObject(
     Napi::Env env, const mg_map *input_map);
 
+[[nodiscard]] std::optional<Napi::Value> MgNodeToNapiNode(
+    DecodeContext &ctx, const mg_node *input_node);
+
+[[nodiscard]] std::optional<Napi::Value> MgRelationshipToNapiRelationship(
+    DecodeContext &ctx, const mg_relationship *input_relationship);
+
+[[nodiscard]] std::optional<Napi::Value>
+MgUnboundRelationshipToNapiRelationship(
+    DecodeContext &ctx,
+    const mg_unbound_relationship *input_unbound_relationship);
+
+[[nodiscard]] std::optional<Napi::Value> MgPathToNapiPath(
+    DecodeContext &ctx, const mg_path *input_path);
+
 [[nodiscard]] std::optional<mg_value *> NapiValueToMgValue(
     Napi::Env env, Napi::Value input_value);
 
+/// Reads a BigInt field which fits into int64, e.g. the days of a date.
+std::optional<int64_t> GetInt64Value(Napi::Object input,
+                                     const std::string &key);
+
+/// Copies the UTF-8 bytes of the string, embedded NULs included. Returns
+/// nullptr if the allocation fails.
+[[nodiscard]] mg_string *NapiStringToMgString(const Napi::String &input_string);
+
 [[nodiscard]] std::optional<mg_map *> NapiObjectToMgMap(
     Napi::Env env, Napi::Object input_value);
 
+/// The payload size: 8 bytes per number, the UTF-8 size of the strings.
+/// Used for the bytes/s throughput, it isn't the exact wire or memory size.
+uint64_t MgValuePayloadBytes(const mg_value *value);
+
+uint64_t MgMapPayloadBytes(const mg_map *value);
+
 }  // namespace nodemg
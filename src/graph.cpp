@@ -0,0 +1,448 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "graph.hpp"
+
+#include "util.hpp"
+
+namespace nodemg {
+
+static const std::string NODEMG_MSG_NOT_CONSTRUCTIBLE =
+    "Graph objects are created only by the client.";
+static const std::string NODEMG_MSG_CONVERSION_FAILED =
+    "Failed to convert the graph object.";
+
+// Passed to the constructors to tell the client calls apart from the JS ones.
+static int construct_tag;
+
+static bool IsConstructedByClient(const Napi::CallbackInfo &info) {
+  return info.Length() == 1 && info[0].IsExternal() &&
+         info[0].As<Napi::External<int>>().Data() == &construct_tag;
+}
+
+static Napi::Object NewWrapper(const Napi::FunctionReference &constructor,
+                               Napi::Env env) {
+  return constructor.New({Napi::External<int>::New(env, &construct_tag)});
+}
+
+// Returns the owner which keeps the value alive together with the pointer
+// which should be referenced. If the context has no owner, the value is
+// copied and the copy becomes the owner.
+template <typename T>
+static std::optional<std::pair<std::shared_ptr<const void>, const T *>> Retain(
+    DecodeContext &ctx, const T *value, T *(*copy)(const T *),
+    void (*destroy)(T *)) {
+  if (ctx.Owner()) {
+    return std::make_pair(ctx.Owner(), value);
+  }
+  T *copied = copy(value);
+  if (!copied) {
+    return std::nullopt;
+  }
+  return std::make_pair(std::shared_ptr<const void>(copied, destroy),
+                        static_cast<const T *>(copied));
+}
+
+static DecodeOptions EagerOptions(DecodeOptions options) {
+  options.lazy_graph = false;
+  return options;
+}
+
+static Napi::Value ConvertedOrThrow(Napi::Env env,
+                                    const std::optional<Napi::Value> &value) {
+  if (!value) {
+    NODEMG_THROW(NODEMG_MSG_CONVERSION_FAILED);
+  }
+  return *value;
+}
+
+// Looks up a single property without converting the whole map.
+static Napi::Value GetMapProperty(const Napi::CallbackInfo &info,
+                                  const DecodeOptions &options,
+                                  const mg_map *properties,
+                                  const Napi::ObjectReference &converted) {
+  auto env = info.Env();
+  if (info.Length() != 1 || !info[0].IsString()) {
+    NODEMG_THROW("The property key has to be a string.");
+  }
+  if (!converted.IsEmpty()) {
+    return converted.Value().Get(info[0]);
+  }
+  auto key = info[0].As<Napi::String>().Utf8Value();
+  auto value = mg_map_at2(properties, static_cast<uint32_t>(key.size()),
+                          key.data());
+  if (!value) {
+    return env.Undefined();
+  }
+  DecodeContext ctx(env, options);
+  return ConvertedOrThrow(env, MgValueToNapiValue(ctx, value));
+}
+
+static Napi::Value ConvertMap(Napi::Env env, const DecodeOptions &options,
+                              const mg_map *properties,
+                              Napi::ObjectReference &converted) {
+  if (converted.IsEmpty()) {
+    DecodeContext ctx(env, options);
+    auto value = ConvertedOrThrow(env, MgMapToNapiObject(ctx, properties));
+    converted = Napi::Persistent(value.As<Napi::Object>());
+  }
+  return converted.Value();
+}
+
+// Node
+
+Napi::FunctionReference Node::constructor;
+
+Napi::Object Node::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(
+      env, "Node",
+      {
+          InstanceAccessor("objectType", &Node::ObjectType, nullptr,
+                           napi_enumerable),
+          InstanceAccessor("id", &Node::Id, nullptr, napi_enumerable),
+          InstanceAccessor("labels", &Node::Labels, nullptr, napi_enumerable),
+          InstanceAccessor("properties", &Node::Properties, nullptr,
+                           napi_enumerable),
+          InstanceMethod("getProperty", &Node::GetProperty),
+          InstanceMethod("toJSON", &Node::ToJSON),
+      });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("Node", func);
+  return exports;
+}
+
+std::optional<Napi::Value> Node::New(DecodeContext &ctx, const mg_node *node) {
+  auto retained = Retain(ctx, node, mg_node_copy, mg_node_destroy);
+  if (!retained) {
+    return std::nullopt;
+  }
+  auto object = NewWrapper(constructor, ctx.Env());
+  auto wrapper = Node::Unwrap(object);
+  wrapper->owner_ = std::move(retained->first);
+  wrapper->node_ = retained->second;
+  wrapper->options_ = ctx.Options();
+  return object;
+}
+
+Node::Node(const Napi::CallbackInfo &info)
+    : Napi::ObjectWrap<Node>(info), node_(nullptr) {
+  auto env = info.Env();
+  if (!IsConstructedByClient(info)) {
+    NODEMG_THROW(NODEMG_MSG_NOT_CONSTRUCTIBLE);
+  }
+}
+
+Napi::Value Node::ObjectType(const Napi::CallbackInfo &info) {
+  return Napi::String::New(info.Env(), "node");
+}
+
+Napi::Value Node::Id(const Napi::CallbackInfo &info) {
+  return IntegerToNapiValue(info.Env(), options_.integers, mg_node_id(node_));
+}
+
+Napi::Value Node::Labels(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  if (labels_.IsEmpty()) {
+    DecodeContext ctx(env, options_);
+    auto label_count = mg_node_label_count(node_);
+    auto labels = Napi::Array::New(env, label_count);
+    for (uint32_t index = 0; index < label_count; ++index) {
+      labels[index] = ctx.Intern(mg_node_label_at(node_, index));
+    }
+    labels_ = Napi::Persistent(Napi::Object(labels));
+  }
+  return labels_.Value();
+}
+
+Napi::Value Node::Properties(const Napi::CallbackInfo &info) {
+  return ConvertMap(info.Env(), options_, mg_node_properties(node_),
+                    properties_);
+}
+
+Napi::Value Node::GetProperty(const Napi::CallbackInfo &info) {
+  return GetMapProperty(info, options_, mg_node_properties(node_),
+                        properties_);
+}
+
+Napi::Value Node::ToJSON(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  DecodeContext ctx(env, EagerOptions(options_));
+  return ConvertedOrThrow(env, MgNodeToNapiNode(ctx, node_));
+}
+
+// Relationship
+
+Napi::FunctionReference Relationship::constructor;
+
+Napi::Object Relationship::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(
+      env, "Relationship",
+      {
+          InstanceAccessor("objectType", &Relationship::ObjectType, nullptr,
+                           napi_enumerable),
+          InstanceAccessor("id", &Relationship::Id, nullptr, napi_enumerable),
+          InstanceAccessor("startNodeId", &Relationship::StartNodeId, nullptr,
+                           napi_enumerable),
+          InstanceAccessor("endNodeId", &Relationship::EndNodeId, nullptr,
+                           napi_enumerable),
+          InstanceAccessor("edgeType", &Relationship::EdgeType, nullptr,
+                           napi_enumerable),
+          InstanceAccessor("properties", &Relationship::Properties, nullptr,
+                           napi_enumerable),
+          InstanceMethod("getProperty", &Relationship::GetProperty),
+          InstanceMethod("toJSON", &Relationship::ToJSON),
+      });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("Relationship", func);
+  return exports;
+}
+
+Relationship *Relationship::Create(DecodeContext &ctx, Napi::Object &object) {
+  object = NewWrapper(constructor, ctx.Env());
+  auto wrapper = Relationship::Unwrap(object);
+  wrapper->options_ = ctx.Options();
+  return wrapper;
+}
+
+std::optional<Napi::Value> Relationship::New(
+    DecodeContext &ctx, const mg_relationship *relationship) {
+  auto retained = Retain(ctx, relationship, mg_relationship_copy,
+                         mg_relationship_destroy);
+  if (!retained) {
+    return std::nullopt;
+  }
+  Napi::Object object;
+  auto wrapper = Create(ctx, object);
+  wrapper->owner_ = std::move(retained->first);
+  wrapper->relationship_ = retained->second;
+  return object;
+}
+
+std::optional<Napi::Value> Relationship::New(
+    DecodeContext &ctx, const mg_unbound_relationship *relationship) {
+  auto retained = Retain(ctx, relationship, mg_unbound_relationship_copy,
+                         mg_unbound_relationship_destroy);
+  if (!retained) {
+    return std::nullopt;
+  }
+  Napi::Object object;
+  auto wrapper = Create(ctx, object);
+  wrapper->owner_ = std::move(retained->first);
+  wrapper->unbound_relationship_ = retained->second;
+  return object;
+}
+
+std::optional<Napi::Value> Relationship::New(
+    DecodeContext &ctx, const mg_unbound_relationship *relationship,
+    int64_t start_id, int64_t end_id) {
+  auto object = New(ctx, relationship);
+  if (!object) {
+    return std::nullopt;
+  }
+  Relationship::Unwrap(object->As<Napi::Object>())->ends_ =
+      std::make_pair(start_id, end_id);
+  return object;
+}
+
+Relationship::Relationship(const Napi::CallbackInfo &info)
+    : Napi::ObjectWrap<Relationship>(info),
+      relationship_(nullptr),
+      unbound_relationship_(nullptr) {
+  auto env = info.Env();
+  if (!IsConstructedByClient(info)) {
+    NODEMG_THROW(NODEMG_MSG_NOT_CONSTRUCTIBLE);
+  }
+}
+
+const mg_map *Relationship::PropertiesMap() const {
+  if (relationship_) {
+    return mg_relationship_properties(relationship_);
+  }
+  return mg_unbound_relationship_properties(unbound_relationship_);
+}
+
+Napi::Value Relationship::ObjectType(const Napi::CallbackInfo &info) {
+  return Napi::String::New(info.Env(), "relationship");
+}
+
+Napi::Value Relationship::Id(const Napi::CallbackInfo &info) {
+  if (relationship_) {
+    return IntegerToNapiValue(info.Env(), options_.integers,
+                              mg_relationship_id(relationship_));
+  }
+  return IntegerToNapiValue(info.Env(), options_.integers,
+                            mg_unbound_relationship_id(unbound_relationship_));
+}
+
+// Unbound relationships without the path context have -1 as a Number (the
+// same as the plain conversion).
+Napi::Value Relationship::StartNodeId(const Napi::CallbackInfo &info) {
+  if (relationship_) {
+    return IntegerToNapiValue(info.Env(), options_.integers,
+                              mg_relationship_start_id(relationship_));
+  }
+  if (ends_) {
+    return IntegerToNapiValue(info.Env(), options_.integers, ends_->first);
+  }
+  return Napi::Number::New(info.Env(), -1);
+}
+
+Napi::Value Relationship::EndNodeId(const Napi::CallbackInfo &info) {
+  if (relationship_) {
+    return IntegerToNapiValue(info.Env(), options_.integers,
+                              mg_relationship_end_id(relationship_));
+  }
+  if (ends_) {
+    return IntegerToNapiValue(info.Env(), options_.integers, ends_->second);
+  }
+  return Napi::Number::New(info.Env(), -1);
+}
+
+Napi::Value Relationship::EdgeType(const Napi::CallbackInfo &info) {
+  auto type = relationship_
+                  ? mg_relationship_type(relationship_)
+                  : mg_unbound_relationship_type(unbound_relationship_);
+  return Napi::String::New(info.Env(), mg_string_data(type),
+                           mg_string_size(type));
+}
+
+Napi::Value Relationship::Properties(const Napi::CallbackInfo &info) {
+  return ConvertMap(info.Env(), options_, PropertiesMap(), properties_);
+}
+
+Napi::Value Relationship::GetProperty(const Napi::CallbackInfo &info) {
+  return GetMapProperty(info, options_, PropertiesMap(), properties_);
+}
+
+Napi::Value Relationship::ToJSON(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  DecodeContext ctx(env, EagerOptions(options_));
+  if (relationship_) {
+    return ConvertedOrThrow(
+        env, MgRelationshipToNapiRelationship(ctx, relationship_));
+  }
+  auto output = ConvertedOrThrow(env, MgUnboundRelationshipToNapiRelationship(
+                                          ctx, unbound_relationship_))
+                    .As<Napi::Object>();
+  if (ends_) {
+    output.Set(ctx[DecodeContext::Field::StartNodeId],
+               ctx.Integer(ends_->first));
+    output.Set(ctx[DecodeContext::Field::EndNodeId],
+               ctx.Integer(ends_->second));
+  }
+  return output;
+}
+
+// Path
+
+Napi::FunctionReference Path::constructor;
+
+Napi::Object Path::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(
+      env, "Path",
+      {
+          InstanceAccessor("objectType", &Path::ObjectType, nullptr,
+                           napi_enumerable),
+          InstanceAccessor("nodes", &Path::Nodes, nullptr, napi_enumerable),
+          InstanceAccessor("relationships", &Path::Relationships, nullptr,
+                           napi_enumerable),
+          InstanceMethod("toJSON", &Path::ToJSON),
+      });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("Path", func);
+  return exports;
+}
+
+std::optional<Napi::Value> Path::New(DecodeContext &ctx, const mg_path *path) {
+  auto retained = Retain(ctx, path, mg_path_copy, mg_path_destroy);
+  if (!retained) {
+    return std::nullopt;
+  }
+  auto object = NewWrapper(constructor, ctx.Env());
+  auto wrapper = Path::Unwrap(object);
+  wrapper->owner_ = std::move(retained->first);
+  wrapper->path_ = retained->second;
+  wrapper->options_ = ctx.Options();
+  return object;
+}
+
+Path::Path(const Napi::CallbackInfo &info)
+    : Napi::ObjectWrap<Path>(info), path_(nullptr) {
+  auto env = info.Env();
+  if (!IsConstructedByClient(info)) {
+    NODEMG_THROW(NODEMG_MSG_NOT_CONSTRUCTIBLE);
+  }
+}
+
+Napi::Value Path::ObjectType(const Napi::CallbackInfo &info) {
+  return Napi::String::New(info.Env(), "path");
+}
+
+Napi::Value Path::Nodes(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  if (nodes_.IsEmpty()) {
+    DecodeContext ctx(env, options_, owner_);
+    auto length = mg_path_length(path_);
+    auto nodes = Napi::Array::New(env, length + 1);
+    for (uint32_t index = 0; index <= length; ++index) {
+      nodes[index] =
+          ConvertedOrThrow(env, Node::New(ctx, mg_path_node_at(path_, index)));
+    }
+    nodes_ = Napi::Persistent(Napi::Object(nodes));
+  }
+  return nodes_.Value();
+}
+
+Napi::Value Path::Relationships(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  if (relationships_.IsEmpty()) {
+    DecodeContext ctx(env, options_, owner_);
+    auto length = mg_path_length(path_);
+    auto relationships = Napi::Array::New(env, length);
+    for (uint32_t index = 0; index < length; ++index) {
+      auto prev_node_id = mg_node_id(mg_path_node_at(path_, index));
+      auto curr_node_id = mg_node_id(mg_path_node_at(path_, index + 1));
+      auto reversed = mg_path_relationship_reversed_at(path_, index);
+      relationships[index] = ConvertedOrThrow(
+          env, Relationship::New(ctx, mg_path_relationship_at(path_, index),
+                                 reversed ? curr_node_id : prev_node_id,
+                                 reversed ? prev_node_id : curr_node_id));
+    }
+    relationships_ = Napi::Persistent(Napi::Object(relationships));
+  }
+  return relationships_.Value();
+}
+
+Napi::Value Path::ToJSON(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  DecodeContext ctx(env, EagerOptions(options_));
+  return ConvertedOrThrow(env, MgPathToNapiPath(ctx, path_));
+}
+
+}  // namespace nodemg
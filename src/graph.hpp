@@ -0,0 +1,120 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <mgclient.h>
+#include <napi.h>
+
+#include <memory>
+#include <optional>
+
+#include "glue.hpp"
+
+namespace nodemg {
+
+// Node, Relationship and Path are the lazy counterparts of the plain objects
+// created by MgNodeToNapiNode & co. They reference the received mg_values
+// (kept alive by the DecodeContext owner) and convert labels, properties,
+// nodes and relationships only once they are accessed. Each converted part
+// is cached on the object. toJSON() returns the plain object.
+//
+// NOTE: A single retained object keeps the whole owner (e.g. all records of
+// a FetchAll) alive.
+
+class Node final : public Napi::ObjectWrap<Node> {
+ public:
+  static Napi::FunctionReference constructor;
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  [[nodiscard]] static std::optional<Napi::Value> New(DecodeContext &ctx,
+                                                      const mg_node *node);
+
+  Node(const Napi::CallbackInfo &info);
+
+  Napi::Value ObjectType(const Napi::CallbackInfo &info);
+  Napi::Value Id(const Napi::CallbackInfo &info);
+  Napi::Value Labels(const Napi::CallbackInfo &info);
+  Napi::Value Properties(const Napi::CallbackInfo &info);
+  Napi::Value GetProperty(const Napi::CallbackInfo &info);
+  Napi::Value ToJSON(const Napi::CallbackInfo &info);
+
+ private:
+  std::shared_ptr<const void> owner_;
+  const mg_node *node_;
+  DecodeOptions options_;
+  Napi::ObjectReference labels_;
+  Napi::ObjectReference properties_;
+};
+
+class Relationship final : public Napi::ObjectWrap<Relationship> {
+ public:
+  static Napi::FunctionReference constructor;
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  [[nodiscard]] static std::optional<Napi::Value> New(
+      DecodeContext &ctx, const mg_relationship *relationship);
+  /// Unbound relationships received on their own have no start and end node.
+  [[nodiscard]] static std::optional<Napi::Value> New(
+      DecodeContext &ctx, const mg_unbound_relationship *relationship);
+  /// Relationships of a path get the start and end node from the path.
+  [[nodiscard]] static std::optional<Napi::Value> New(
+      DecodeContext &ctx, const mg_unbound_relationship *relationship,
+      int64_t start_id, int64_t end_id);
+
+  Relationship(const Napi::CallbackInfo &info);
+
+  Napi::Value ObjectType(const Napi::CallbackInfo &info);
+  Napi::Value Id(const Napi::CallbackInfo &info);
+  Napi::Value StartNodeId(const Napi::CallbackInfo &info);
+  Napi::Value EndNodeId(const Napi::CallbackInfo &info);
+  Napi::Value EdgeType(const Napi::CallbackInfo &info);
+  Napi::Value Properties(const Napi::CallbackInfo &info);
+  Napi::Value GetProperty(const Napi::CallbackInfo &info);
+  Napi::Value ToJSON(const Napi::CallbackInfo &info);
+
+ private:
+  std::shared_ptr<const void> owner_;
+  // Exactly one of the two is set on an initialized object.
+  const mg_relationship *relationship_;
+  const mg_unbound_relationship *unbound_relationship_;
+  std::optional<std::pair<int64_t, int64_t>> ends_;
+  DecodeOptions options_;
+  Napi::ObjectReference properties_;
+
+  static Relationship *Create(DecodeContext &ctx, Napi::Object &object);
+  const mg_map *PropertiesMap() const;
+};
+
+class Path final : public Napi::ObjectWrap<Path> {
+ public:
+  static Napi::FunctionReference constructor;
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  [[nodiscard]] static std::optional<Napi::Value> New(DecodeContext &ctx,
+                                                      const mg_path *path);
+
+  Path(const Napi::CallbackInfo &info);
+
+  Napi::Value ObjectType(const Napi::CallbackInfo &info);
+  Napi::Value Nodes(const Napi::CallbackInfo &info);
+  Napi::Value Relationships(const Napi::CallbackInfo &info);
+  Napi::Value ToJSON(const Napi::CallbackInfo &info);
+
+ private:
+  std::shared_ptr<const void> owner_;
+  const mg_path *path_;
+  DecodeOptions options_;
+  Napi::ObjectReference nodes_;
+  Napi::ObjectReference relationships_;
+};
+
+}  // namespace nodemg
@@ -0,0 +1,124 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "io_thread.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace nodemg {
+
+IoThread::IoThread(Napi::Env env, Client *client, mg::Client *mg_client)
+    : mg_client_(mg_client),
+      stats_(client->Metrics()),
+      client_ref_(Napi::Weak(client->Value())),
+      done_(Napi::ThreadSafeFunction::New(
+          env, Napi::Function::New(env, [](const Napi::CallbackInfo &) {}),
+          "nodemgclient", 0, 1)),
+      head_(nullptr),
+      stop_(false),
+      in_flight_(0) {
+  // An idle connection doesn't keep the event loop alive.
+  done_.Unref(env);
+  thread_ = std::thread([this] { Run(); });
+}
+
+IoThread::~IoThread() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_one();
+  thread_.join();
+  done_.Release();
+}
+
+void IoThread::Push(Napi::Env env, std::unique_ptr<Command> command) {
+  if (in_flight_++ == 0) {
+    client_ref_.Ref();
+    done_.Ref(env);
+  }
+  auto *node = new Node{std::move(command), nullptr};
+  // The node belongs to the I/O thread once it's published, so the previous
+  // head is kept aside.
+  auto *head = head_.load(std::memory_order_relaxed);
+  do {
+    node->next = head;
+  } while (!head_.compare_exchange_weak(head, node, std::memory_order_release,
+                                        std::memory_order_relaxed));
+  if (head == nullptr) {
+    // The I/O thread may be parked, it takes everything pushed until it
+    // wakes up.
+    std::lock_guard<std::mutex> lock(mutex_);
+    wake_.notify_one();
+  }
+}
+
+IoThread::Batch IoThread::Take() {
+  auto *node = head_.exchange(nullptr, std::memory_order_acquire);
+  Batch batch;
+  while (node) {
+    batch.emplace_back(std::move(node->command));
+    auto *next = node->next;
+    delete node;
+    node = next;
+  }
+  std::reverse(batch.begin(), batch.end());
+  return batch;
+}
+
+void IoThread::Run() {
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [this] {
+        return stop_ || head_.load(std::memory_order_acquire) != nullptr;
+      });
+      if (stop_) {
+        return;
+      }
+    }
+    auto batch = std::make_unique<Batch>(Take());
+    for (auto &command : *batch) {
+      stats_->queue_wait.Record(ElapsedNanoseconds(command->Enqueued()));
+      RunCommand(mg_client_, *command, *stats_);
+    }
+    auto *done = batch.release();
+    auto status = done_.NonBlockingCall(
+        done, [this](Napi::Env env, Napi::Function, Batch *finished) {
+          OnDone(env, finished);
+        });
+    if (status != napi_ok) {
+      // The environment is shutting down, nobody waits for the Promises.
+      delete done;
+    }
+  }
+}
+
+void IoThread::OnDone(Napi::Env env, Batch *batch) {
+  std::unique_ptr<Batch> owned(batch);
+  if (env == nullptr) {
+    return;
+  }
+  for (auto &command : *owned) {
+    SettleCommand(env, *command, *stats_);
+  }
+  in_flight_ -= owned->size();
+  if (in_flight_ == 0) {
+    done_.Unref(env);
+    client_ref_.Unref();
+  }
+}
+
+}  // namespace nodemg
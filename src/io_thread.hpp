@@ -0,0 +1,78 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <napi.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mgclient.hpp>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "client.hpp"
+#include "stats.hpp"
+
+namespace nodemg {
+
+/// Executes the commands of one Client on a thread of its own instead of the
+/// libuv threadpool, so that slow queries don't hold threadpool threads
+/// needed by fs, dns or other connections. The main thread pushes commands
+/// onto a lock-free stack, the I/O thread takes all of them at once, runs
+/// them in order and hands the batch back through a ThreadSafeFunction. The
+/// mutex only parks the idle I/O thread.
+class IoThread final {
+ public:
+  IoThread(Napi::Env env, Client *client, mg::Client *mg_client);
+  /// Stops and joins the thread. The Client is referenced while commands
+  /// are in flight, so the thread is idle by then.
+  ~IoThread();
+  IoThread(const IoThread &) = delete;
+  IoThread &operator=(const IoThread &) = delete;
+
+  /// Main thread. The command is executed after all previously pushed ones.
+  void Push(Napi::Env env, std::unique_ptr<Command> command);
+
+ private:
+  struct Node {
+    std::unique_ptr<Command> command;
+    Node *next;
+  };
+  using Batch = std::vector<std::unique_ptr<Command>>;
+
+  void Run();
+  // Takes all pushed commands in the push order.
+  Batch Take();
+  void OnDone(Napi::Env env, Batch *batch);
+
+  mg::Client *mg_client_;
+  std::shared_ptr<ClientStats> stats_;
+  // Weak, but referenced while commands are in flight, which keeps the
+  // Client (and the underlying connection) alive.
+  Napi::ObjectReference client_ref_;
+  Napi::ThreadSafeFunction done_;
+  // Pushed commands, the newest first.
+  std::atomic<Node *> head_;
+  std::atomic<bool> stop_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  // Pushed but not yet settled, main thread only.
+  size_t in_flight_;
+  std::thread thread_;
+};
+
+}  // namespace nodemg
@@ -0,0 +1,458 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "params.hpp"
+
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "util.hpp"
+
+namespace nodemg {
+
+// ParamWriter
+
+ParamWriter::ParamWriter(Napi::Env env, std::shared_ptr<ArenaPool> arenas)
+    : env_(env), arenas_(std::move(arenas)) {
+  if (arenas_) {
+    data_ = arenas_->Acquire();
+  }
+}
+
+template <typename T>
+void ParamWriter::Put(T value) {
+  auto size = data_.size();
+  data_.resize(size + sizeof(T));
+  std::memcpy(data_.data() + size, &value, sizeof(T));
+}
+
+void ParamWriter::PutTag(ParamTag tag) { Put(static_cast<uint8_t>(tag)); }
+
+bool ParamWriter::PutSize(size_t size) {
+  auto env = env_;
+  if (size > std::numeric_limits<uint32_t>::max()) {
+    NODEMG_THROW("The query parameter is too large.");
+    return false;
+  }
+  Put(static_cast<uint32_t>(size));
+  return true;
+}
+
+// The UTF-8 bytes are written straight into the buffer, without an
+// intermediate std::string.
+bool ParamWriter::PutString(Napi::String value) {
+  auto env = env_;
+  size_t size = 0;
+  if (napi_get_value_string_utf8(env, value, nullptr, 0, &size) != napi_ok ||
+      !PutSize(size)) {
+    NODEMG_THROW("Fail to read the JS string.");
+    return false;
+  }
+  auto offset = data_.size();
+  // Room for the terminating NUL, which is dropped afterwards.
+  data_.resize(offset + size + 1);
+  size_t written = 0;
+  if (napi_get_value_string_utf8(
+          env, value, reinterpret_cast<char *>(data_.data() + offset),
+          size + 1, &written) != napi_ok ||
+      written != size) {
+    NODEMG_THROW("Fail to read the JS string.");
+    return false;
+  }
+  data_.resize(offset + size);
+  return true;
+}
+
+bool ParamWriter::PutList(Napi::Array value) {
+  auto size = value.Length();
+  PutTag(ParamTag::List);
+  Put(size);
+  for (uint32_t index = 0; index < size; ++index) {
+    if (!PutValue(value[index])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ParamWriter::PutMap(Napi::Object value) {
+  auto keys = value.GetPropertyNames();
+  auto size = keys.Length();
+  PutTag(ParamTag::Map);
+  Put(size);
+  for (uint32_t index = 0; index < size; ++index) {
+    Napi::Value key = keys[index];
+    if (!PutString(key.As<Napi::String>()) || !PutValue(value.Get(key))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Same element types as NapiTypedArrayToMgList, copied with a single memcpy
+// when the element type is already i64 or f64.
+template <typename Element, typename Output>
+bool ParamWriter::PutElements(Napi::TypedArray value, ParamTag tag) {
+  auto env = env_;
+  auto size = value.ElementLength();
+  PutTag(tag);
+  if (!PutSize(size)) {
+    return false;
+  }
+  const Element *elements = value.As<Napi::TypedArrayOf<Element>>().Data();
+  auto offset = data_.size();
+  data_.resize(offset + size * sizeof(Output));
+  if constexpr (std::is_same_v<Element, Output>) {
+    std::memcpy(data_.data() + offset, elements, size * sizeof(Output));
+  } else {
+    for (size_t index = 0; index < size; ++index) {
+      if constexpr (std::is_same_v<Element, uint64_t>) {
+        if (elements[index] >
+            static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+          NODEMG_THROW("Fail to losslessly convert value to Memgraph int64.");
+          return false;
+        }
+      }
+      auto element = static_cast<Output>(elements[index]);
+      std::memcpy(data_.data() + offset + index * sizeof(Output), &element,
+                  sizeof(Output));
+    }
+  }
+  return true;
+}
+
+bool ParamWriter::PutTypedArray(Napi::TypedArray value) {
+  auto env = env_;
+  switch (value.TypedArrayType()) {
+    case napi_int8_array:
+      return PutElements<int8_t, int64_t>(value, ParamTag::IntegerList);
+    case napi_uint8_array:
+    case napi_uint8_clamped_array:
+      return PutElements<uint8_t, int64_t>(value, ParamTag::IntegerList);
+    case napi_int16_array:
+      return PutElements<int16_t, int64_t>(value, ParamTag::IntegerList);
+    case napi_uint16_array:
+      return PutElements<uint16_t, int64_t>(value, ParamTag::IntegerList);
+    case napi_int32_array:
+      return PutElements<int32_t, int64_t>(value, ParamTag::IntegerList);
+    case napi_uint32_array:
+      return PutElements<uint32_t, int64_t>(value, ParamTag::IntegerList);
+    case napi_bigint64_array:
+      return PutElements<int64_t, int64_t>(value, ParamTag::IntegerList);
+    case napi_biguint64_array:
+      return PutElements<uint64_t, int64_t>(value, ParamTag::IntegerList);
+    case napi_float32_array:
+      return PutElements<float, double>(value, ParamTag::FloatList);
+    case napi_float64_array:
+      return PutElements<double, double>(value, ParamTag::FloatList);
+    default:
+      NODEMG_THROW("Unsupported typed array type.");
+      return false;
+  }
+}
+
+bool ParamWriter::PutTemporal(Napi::Object value) {
+  auto env = env_;
+  auto object_type = value.Get("objectType").As<Napi::String>().Utf8Value();
+  if (object_type == "date") {
+    auto days = GetInt64Value(value, "days");
+    if (!days) {
+      NODEMG_THROW("Converting JS date to Memgraph date failed!");
+      return false;
+    }
+    PutTag(ParamTag::Date);
+    Put(*days);
+  } else if (object_type == "local_time") {
+    auto nanoseconds = GetInt64Value(value, "nanoseconds");
+    if (!nanoseconds) {
+      NODEMG_THROW("Converting JS local time to Memgraph local time failed!");
+      return false;
+    }
+    PutTag(ParamTag::LocalTime);
+    Put(*nanoseconds);
+  } else if (object_type == "local_date_time") {
+    auto seconds = GetInt64Value(value, "seconds");
+    auto nanoseconds = GetInt64Value(value, "nanoseconds");
+    if (!seconds || !nanoseconds) {
+      NODEMG_THROW(
+          "Converting JS local date time to Memgraph local date time "
+          "failed!");
+      return false;
+    }
+    PutTag(ParamTag::LocalDateTime);
+    Put(*seconds);
+    Put(*nanoseconds);
+  } else if (object_type == "duration") {
+    auto days = GetInt64Value(value, "days");
+    auto seconds = GetInt64Value(value, "seconds");
+    auto nanoseconds = GetInt64Value(value, "nanoseconds");
+    if (!days || !seconds || !nanoseconds) {
+      NODEMG_THROW("Converting JS duration to Memgraph duration failed!");
+      return false;
+    }
+    PutTag(ParamTag::Duration);
+    Put(*days);
+    Put(*seconds);
+    Put(*nanoseconds);
+  } else {
+    NODEMG_THROW("Unknown type of JS Object!");
+    return false;
+  }
+  return true;
+}
+
+// Accepts the same values as NapiValueToMgValue.
+bool ParamWriter::PutValue(Napi::Value value) {
+  auto env = env_;
+  if (value.IsEmpty() || value.IsUndefined() || value.IsNull()) {
+    PutTag(ParamTag::Null);
+  } else if (value.IsBoolean()) {
+    PutTag(value.As<Napi::Boolean>().Value() ? ParamTag::True
+                                             : ParamTag::False);
+  } else if (value.IsBigInt()) {
+    bool lossless;
+    int64_t as_int64 = value.As<Napi::BigInt>().Int64Value(&lossless);
+    if (!lossless) {
+      NODEMG_THROW("Fail to losslessly convert value to Memgraph int64.");
+      return false;
+    }
+    PutTag(ParamTag::Integer);
+    Put(as_int64);
+  } else if (value.IsNumber()) {
+    PutTag(ParamTag::Float);
+    Put(value.As<Napi::Number>().DoubleValue());
+  } else if (value.IsString()) {
+    PutTag(ParamTag::String);
+    return PutString(value.As<Napi::String>());
+  } else if (value.IsArray()) {
+    return PutList(value.As<Napi::Array>());
+  } else if (value.IsTypedArray()) {
+    return PutTypedArray(value.As<Napi::TypedArray>());
+  } else if (value.IsObject()) {
+    auto object = value.As<Napi::Object>();
+    if (object.Has("objectType")) {
+      return PutTemporal(object);
+    }
+    return PutMap(object);
+  } else {
+    NODEMG_THROW("Unrecognized JavaScript value.");
+    return false;
+  }
+  return true;
+}
+
+ParamSnapshot ParamWriter::Finish(std::shared_ptr<const ParamKeys> keys) {
+  return ParamSnapshot(std::move(data_), std::move(keys), arenas_);
+}
+
+std::optional<ParamSnapshot> NapiObjectToParamSnapshot(
+    Napi::Env env, Napi::Object params, std::shared_ptr<ArenaPool> arenas) {
+  ParamWriter writer(env, std::move(arenas));
+  if (!writer.PutMap(params)) {
+    return std::nullopt;
+  }
+  return writer.Finish();
+}
+
+// ParamSnapshot
+
+namespace {
+
+template <typename T>
+T *Checked(T *value) {
+  if (!value) {
+    throw std::bad_alloc();
+  }
+  return value;
+}
+
+// Wraps the content into a value, the content is destroyed on failure.
+template <typename T>
+MgValuePtr MakeValue(T *content, mg_value *(*make)(T *),
+                     void (*destroy)(T *)) {
+  Checked(content);
+  MgValuePtr value(make(content));
+  if (!value) {
+    destroy(content);
+    throw std::bad_alloc();
+  }
+  return value;
+}
+
+// Runs on the worker thread, the input was validated by ParamWriter.
+class ParamReader {
+ public:
+  ParamReader(const std::vector<uint8_t> &data, size_t offset)
+      : data_(data), offset_(offset) {}
+
+  MgValuePtr ReadValue() {
+    switch (static_cast<ParamTag>(Get<uint8_t>())) {
+      case ParamTag::Null:
+        return MgValuePtr(Checked(mg_value_make_null()));
+      case ParamTag::False:
+        return MgValuePtr(Checked(mg_value_make_bool(0)));
+      case ParamTag::True:
+        return MgValuePtr(Checked(mg_value_make_bool(1)));
+      case ParamTag::Integer:
+        return MgValuePtr(Checked(mg_value_make_integer(Get<int64_t>())));
+      case ParamTag::Float:
+        return MgValuePtr(Checked(mg_value_make_float(Get<double>())));
+      case ParamTag::String:
+        return MakeValue(ReadString().release(), mg_value_make_string2,
+                         mg_string_destroy);
+      case ParamTag::List:
+        return MakeValue(ReadList().release(), mg_value_make_list,
+                         mg_list_destroy);
+      case ParamTag::IntegerList:
+        return MakeValue(ReadElements<int64_t>(mg_value_make_integer).release(),
+                         mg_value_make_list, mg_list_destroy);
+      case ParamTag::FloatList:
+        return MakeValue(ReadElements<double>(mg_value_make_float).release(),
+                         mg_value_make_list, mg_list_destroy);
+      case ParamTag::Map:
+        return MakeValue(ReadMap().release(), mg_value_make_map,
+                         mg_map_destroy);
+      case ParamTag::Date:
+        return MakeValue(mg_date_make(Get<int64_t>()), mg_value_make_date,
+                         mg_date_destroy);
+      case ParamTag::LocalTime:
+        return MakeValue(mg_local_time_make(Get<int64_t>()),
+                         mg_value_make_local_time, mg_local_time_destroy);
+      case ParamTag::LocalDateTime: {
+        auto seconds = Get<int64_t>();
+        auto nanoseconds = Get<int64_t>();
+        return MakeValue(mg_local_date_time_make(seconds, nanoseconds),
+                         mg_value_make_local_date_time,
+                         mg_local_date_time_destroy);
+      }
+      case ParamTag::Duration: {
+        auto days = Get<int64_t>();
+        auto seconds = Get<int64_t>();
+        auto nanoseconds = Get<int64_t>();
+        return MakeValue(mg_duration_make(0, days, seconds, nanoseconds),
+                         mg_value_make_duration, mg_duration_destroy);
+      }
+    }
+    throw std::logic_error("Unknown query parameter tag.");
+  }
+
+  MgMapPtr ReadMap() {
+    auto size = Get<uint32_t>();
+    MgMapPtr output_map(Checked(mg_map_make_empty(size)));
+    for (uint32_t index = 0; index < size; ++index) {
+      auto key = ReadString();
+      auto value = ReadValue();
+      if (mg_map_insert_unsafe2(output_map.get(), key.get(), value.get()) !=
+          0) {
+        throw std::bad_alloc();
+      }
+      key.release();
+      value.release();
+    }
+    return output_map;
+  }
+
+ private:
+  const std::vector<uint8_t> &data_;
+  size_t offset_;
+
+  template <typename T>
+  T Get() {
+    T value;
+    std::memcpy(&value, data_.data() + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return value;
+  }
+
+  MgStringPtr ReadString() {
+    auto size = Get<uint32_t>();
+    MgStringPtr output_string(Checked(mg_string_make2(
+        size, reinterpret_cast<const char *>(data_.data() + offset_))));
+    offset_ += size;
+    return output_string;
+  }
+
+  MgListPtr ReadList() {
+    auto size = Get<uint32_t>();
+    MgListPtr output_list(Checked(mg_list_make_empty(size)));
+    for (uint32_t index = 0; index < size; ++index) {
+      auto value = ReadValue();
+      if (mg_list_append(output_list.get(), value.get()) != 0) {
+        throw std::bad_alloc();
+      }
+      value.release();
+    }
+    return output_list;
+  }
+
+  template <typename T>
+  MgListPtr ReadElements(mg_value *(*make)(T)) {
+    auto size = Get<uint32_t>();
+    MgListPtr output_list(Checked(mg_list_make_empty(size)));
+    for (uint32_t index = 0; index < size; ++index) {
+      MgValuePtr value(Checked(make(Get<T>())));
+      if (mg_list_append(output_list.get(), value.get()) != 0) {
+        throw std::bad_alloc();
+      }
+      value.release();
+    }
+    return output_list;
+  }
+};
+
+}  // namespace
+
+ParamSnapshot::ParamSnapshot(std::vector<uint8_t> data,
+                             std::shared_ptr<const ParamKeys> keys,
+                             std::shared_ptr<ArenaPool> arenas)
+    : data_(std::move(data)),
+      keys_(std::move(keys)),
+      arenas_(std::move(arenas)) {}
+
+ParamSnapshot::~ParamSnapshot() {
+  if (arenas_) {
+    arenas_->Release(std::move(data_));
+  }
+}
+
+MgMapPtr ParamSnapshot::Build() const {
+  if (keys_) {
+    ParamReader reader(data_, 0);
+    MgMapPtr output_map(
+        Checked(mg_map_make_empty(static_cast<uint32_t>(keys_->size()))));
+    for (const auto &prebuilt_key : *keys_) {
+      MgStringPtr key(Checked(mg_string_copy(prebuilt_key.get())));
+      auto value = reader.ReadValue();
+      if (mg_map_insert_unsafe2(output_map.get(), key.get(), value.get()) !=
+          0) {
+        throw std::bad_alloc();
+      }
+      key.release();
+      value.release();
+    }
+    return output_map;
+  }
+  if (data_.empty()) {
+    return nullptr;
+  }
+  // Skips the tag of the top-level Map.
+  ParamReader reader(data_, 1);
+  return reader.ReadMap();
+}
+
+}  // namespace nodemg
@@ -0,0 +1,130 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <mgclient.h>
+#include <napi.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "arena.hpp"
+#include "glue.hpp"
+
+namespace nodemg {
+
+// Query parameters are encoded in two steps. On the main thread the JS
+// values are validated and copied into one flat buffer (ParamWriter), which
+// takes a single allocation for primitives, string bytes and typed arrays.
+// The mg_map tree, which costs an allocation per value, is built from the
+// buffer on the worker thread (ParamSnapshot::Build). The buffers are
+// recycled through the ArenaPool of the client.
+//
+// Every value starts with a u8 ParamTag, numbers are in the host byte order:
+//
+//   Integer, Date, LocalTime:  i64
+//   Float:                     f64
+//   LocalDateTime:             i64 seconds, i64 nanoseconds
+//   Duration:                  i64 days, i64 seconds, i64 nanoseconds
+//   String:                    u32 size, UTF-8 bytes
+//   List:                      u32 size, values
+//   IntegerList, FloatList:    u32 size, i64 / f64 elements
+//   Map:                       u32 size, (u32 key size, key bytes, value)
+enum class ParamTag : uint8_t {
+  Null,
+  False,
+  True,
+  Integer,
+  Float,
+  String,
+  List,
+  IntegerList,
+  FloatList,
+  Map,
+  Date,
+  LocalTime,
+  LocalDateTime,
+  Duration,
+};
+
+/// Keys of the top-level map prebuilt by a Statement.
+using ParamKeys = std::vector<MgStringPtr>;
+
+/// The encoded parameters of a single query. It doesn't reference any JS
+/// value, so it can be moved to and consumed on the worker thread.
+class ParamSnapshot {
+ public:
+  /// No parameters.
+  ParamSnapshot() = default;
+  ParamSnapshot(std::vector<uint8_t> data,
+                std::shared_ptr<const ParamKeys> keys,
+                std::shared_ptr<ArenaPool> arenas);
+  ParamSnapshot(ParamSnapshot &&) = default;
+  ParamSnapshot &operator=(ParamSnapshot &&) = default;
+  /// Returns the buffer to the arenas.
+  ~ParamSnapshot();
+
+  /// Builds the parameters map, nullptr if there are no parameters. Throws
+  /// std::bad_alloc if mgclient fails to allocate a value.
+  MgMapPtr Build() const;
+
+ private:
+  // Either a single Map value or, if keys_ is set, one value per key.
+  std::vector<uint8_t> data_;
+  std::shared_ptr<const ParamKeys> keys_;
+  std::shared_ptr<ArenaPool> arenas_;
+};
+
+/// Copies JS values into a ParamSnapshot on the main thread. Values which
+/// can't be passed to Memgraph throw a JS error and make Put* return false.
+class ParamWriter {
+ public:
+  /// The buffer is taken from the arenas if they are given.
+  explicit ParamWriter(Napi::Env env,
+                       std::shared_ptr<ArenaPool> arenas = nullptr);
+
+  [[nodiscard]] bool PutValue(Napi::Value value);
+  /// Writes the object as a Map value.
+  [[nodiscard]] bool PutMap(Napi::Object value);
+
+  /// With keys, the written values are the values of the keys in order.
+  ParamSnapshot Finish(std::shared_ptr<const ParamKeys> keys = nullptr);
+
+ private:
+  Napi::Env env_;
+  std::shared_ptr<ArenaPool> arenas_;
+  std::vector<uint8_t> data_;
+
+  template <typename T>
+  void Put(T value);
+  void PutTag(ParamTag tag);
+  [[nodiscard]] bool PutSize(size_t size);
+  [[nodiscard]] bool PutString(Napi::String value);
+  [[nodiscard]] bool PutList(Napi::Array value);
+  [[nodiscard]] bool PutTypedArray(Napi::TypedArray value);
+  template <typename Element, typename Output>
+  [[nodiscard]] bool PutElements(Napi::TypedArray value, ParamTag tag);
+  [[nodiscard]] bool PutTemporal(Napi::Object value);
+};
+
+/// Encodes the parameters object on the main thread. Throws a JS error and
+/// returns std::nullopt on invalid input.
+[[nodiscard]] std::optional<ParamSnapshot> NapiObjectToParamSnapshot(
+    Napi::Env env, Napi::Object params,
+    std::shared_ptr<ArenaPool> arenas = nullptr);
+
+}  // namespace nodemg
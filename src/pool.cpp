@@ -0,0 +1,354 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pool.hpp"
+
+#include "util.hpp"
+
+namespace nodemg {
+
+static const std::string CFG_POOL_MIN = "min";
+static const std::string CFG_POOL_MAX = "max";
+
+Napi::FunctionReference Pool::constructor;
+
+Napi::Object Pool::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func =
+      DefineClass(env, "Pool",
+                  {
+                      InstanceMethod("Connect", &Pool::Connect),
+                      InstanceMethod("Acquire", &Pool::Acquire),
+                      InstanceMethod("Release", &Pool::Release),
+                      InstanceMethod("Close", &Pool::Close),
+                      InstanceMethod("Status", &Pool::Status),
+                      InstanceMethod("Stats", &Pool::Stats),
+                      InstanceMethod("ResetStats", &Pool::ResetStats),
+                  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("Pool", func);
+  return exports;
+}
+
+Pool::Pool(const Napi::CallbackInfo &info)
+    : Napi::ObjectWrap<Pool>(info),
+      name_("nodemgclient"),
+      min_size_(1),
+      max_size_(1),
+      closed_(false),
+      opening_(0),
+      warmup_remaining_(0) {
+  if (info.Length() == 1) {
+    name_ = info[0].As<Napi::String>().Utf8Value();
+  }
+}
+
+Pool::~Pool() {}
+
+class AsyncPoolConnectWorker final : public Napi::AsyncWorker {
+ public:
+  AsyncPoolConnectWorker(Napi::Env env, Pool *pool, Napi::Object pool_object,
+                         mg::Client::Params params, bool warmup)
+      : AsyncWorker(Napi::Function::New(env, [](const Napi::CallbackInfo &) {
+        })),
+        pool_(pool),
+        pool_ref_(Napi::Persistent(pool_object)),
+        params_(std::move(params)),
+        warmup_(warmup) {}
+  ~AsyncPoolConnectWorker() = default;
+
+  void Execute() {
+    static const std::string NODEMG_MSG_CONNECT_FAILED =
+        "Connect failed. Ensure Memgraph is running and Pool is properly "
+        "configured.";
+    try {
+      mg::Client::Init();
+      client_ = mg::Client::Connect(params_);
+      if (!client_) {
+        SetError(NODEMG_MSG_CONNECT_FAILED);
+        return;
+      }
+    } catch (const std::exception &error) {
+      SetError(NODEMG_MSG_CONNECT_FAILED + " " + error.what());
+      return;
+    }
+  }
+
+  void OnOK() {
+    Napi::Object obj = Client::constructor.New({});
+    Client::Unwrap(obj)->SetMgClient(std::move(client_));
+    pool_->OnConnected(obj, warmup_);
+  }
+
+  void OnError(const Napi::Error &e) {
+    pool_->OnConnectFailed(e.Message(), warmup_);
+  }
+
+ private:
+  Pool *pool_;
+  // Keeps the pool alive until the connect is finished.
+  Napi::ObjectReference pool_ref_;
+  mg::Client::Params params_;
+  // Opened by Connect, as opposed to Acquire or Release.
+  bool warmup_;
+  std::unique_ptr<mg::Client> client_;
+};
+
+void Pool::OpenConnection(bool warmup) {
+  ++opening_;
+  auto wk =
+      new AsyncPoolConnectWorker(Env(), this, Value(), *params_, warmup);
+  wk->Queue();
+}
+
+void Pool::Lease(Client *client, const Napi::Promise::Deferred &deferred) {
+  leased_.insert(client);
+  deferred.Resolve(clients_.at(client).Value());
+}
+
+void Pool::Drop(Client *client) {
+  leased_.erase(client);
+  // Once the reference is gone, GC takes care of closing the connection.
+  clients_.erase(client);
+}
+
+void Pool::OnConnected(Napi::Object client_object, bool warmup) {
+  --opening_;
+  auto client = Client::Unwrap(client_object);
+  if (closed_) {
+    return;
+  }
+  client->Configure(Env(), settings_);
+  clients_.emplace(client, Napi::Persistent(client_object));
+  if (!waiters_.empty()) {
+    auto deferred = waiters_.front();
+    waiters_.pop_front();
+    Lease(client, deferred);
+  } else {
+    idle_.push_back(client);
+  }
+  if (warmup && warmup_ && --warmup_remaining_ == 0) {
+    warmup_->Resolve(Value());
+    warmup_.reset();
+  }
+}
+
+void Pool::OnConnectFailed(const std::string &message, bool warmup) {
+  --opening_;
+  auto env = Env();
+  if (warmup && warmup_) {
+    warmup_->Reject(Napi::Error::New(env, message).Value());
+    warmup_.reset();
+    // Connect may be called again once the other connects are finished.
+    params_.reset();
+  }
+  // Somebody asked for the connection which failed to open. Unless a leased
+  // connection is going to come back, the oldest waiter gets the error
+  // instead of waiting for a connection which may never come.
+  if (waiters_.size() > opening_ + leased_.size()) {
+    auto deferred = waiters_.front();
+    waiters_.pop_front();
+    deferred.Reject(Napi::Error::New(env, message).Value());
+  }
+}
+
+Napi::Value Pool::Connect(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+
+  if (params_) {
+    NODEMG_THROW("Pool is already connected.");
+    return env.Undefined();
+  }
+  // Left over from a failed Connect, they would count towards this one.
+  if (opening_ > 0) {
+    NODEMG_THROW("Pool is still connecting.");
+    return env.Undefined();
+  }
+
+  auto params = NapiObjectToMgClientParams(
+      env, info.Length() > 0 ? info[0] : Napi::Value(), name_);
+  if (!params) {
+    return env.Undefined();
+  }
+
+  static const std::string NODEMG_MSG_WRONG_POOL_ARG =
+      "Wrong pool argument. An object containing { min, max } is required, "
+      "where 0 <= min <= max and max >= 1.";
+  uint32_t min_size = min_size_;
+  uint32_t max_size = max_size_;
+  if (info.Length() > 1) {
+    if (!info[1].IsObject()) {
+      NODEMG_THROW(NODEMG_MSG_WRONG_POOL_ARG);
+      return env.Undefined();
+    }
+    auto pool_params = info[1].As<Napi::Object>();
+    if (pool_params.Has(CFG_POOL_MIN)) {
+      auto napi_min = pool_params.Get(CFG_POOL_MIN);
+      if (!napi_min.IsNumber()) {
+        NODEMG_THROW(NODEMG_MSG_WRONG_POOL_ARG);
+        return env.Undefined();
+      }
+      min_size = napi_min.ToNumber().Uint32Value();
+    }
+    if (pool_params.Has(CFG_POOL_MAX)) {
+      auto napi_max = pool_params.Get(CFG_POOL_MAX);
+      if (!napi_max.IsNumber()) {
+        NODEMG_THROW(NODEMG_MSG_WRONG_POOL_ARG);
+        return env.Undefined();
+      }
+      max_size = napi_max.ToNumber().Uint32Value();
+    }
+  }
+  if (max_size < 1 || min_size > max_size) {
+    NODEMG_THROW(NODEMG_MSG_WRONG_POOL_ARG);
+    return env.Undefined();
+  }
+  params_ = std::move(*params);
+  settings_ = info.Length() > 0 ? NapiObjectToClientSettings(info[0])
+                                : ClientSettings();
+  min_size_ = min_size;
+  max_size_ = max_size;
+
+  Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+  if (min_size_ == 0) {
+    deferred.Resolve(Value());
+    return deferred.Promise();
+  }
+  // All initial connects are queued at once so that they are opened in
+  // parallel on the threadpool.
+  warmup_ = deferred;
+  warmup_remaining_ = min_size_;
+  for (uint32_t index = 0; index < min_size_; ++index) {
+    OpenConnection(true);
+  }
+  return deferred.Promise();
+}
+
+Napi::Value Pool::Acquire(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+
+  if (!params_) {
+    NODEMG_THROW("Pool is not connected.");
+    return env.Undefined();
+  }
+
+  Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+  if (closed_) {
+    deferred.Reject(Napi::Error::New(env, "Pool is closed.").Value());
+    return deferred.Promise();
+  }
+  if (!idle_.empty() && waiters_.empty()) {
+    auto client = idle_.front();
+    idle_.pop_front();
+    Lease(client, deferred);
+    return deferred.Promise();
+  }
+  waiters_.push_back(deferred);
+  if (clients_.size() + opening_ < max_size_) {
+    OpenConnection();
+  }
+  return deferred.Promise();
+}
+
+Napi::Value Pool::Release(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsObject() ||
+      !info[0].As<Napi::Object>().InstanceOf(Client::constructor.Value())) {
+    NODEMG_THROW("Release requires a Client acquired from this pool.");
+    return env.Undefined();
+  }
+  auto client = Client::Unwrap(info[0].As<Napi::Object>());
+  if (leased_.find(client) == leased_.end()) {
+    NODEMG_THROW("The Client is not leased from this pool.");
+    return env.Undefined();
+  }
+  bool discard = info.Length() > 1 && info[1].ToBoolean().Value();
+
+  if (closed_ || discard) {
+    Drop(client);
+    // Keep the pool at its minimal size, and replace the connection if
+    // somebody is waiting for one. Not after a failed Connect.
+    auto size = clients_.size() + opening_;
+    if (!closed_ && params_ && (size < min_size_ ||
+                     (!waiters_.empty() && size < max_size_))) {
+      OpenConnection();
+    }
+    return env.Undefined();
+  }
+  leased_.erase(client);
+  if (!waiters_.empty()) {
+    auto deferred = waiters_.front();
+    waiters_.pop_front();
+    Lease(client, deferred);
+  } else {
+    idle_.push_back(client);
+  }
+  return env.Undefined();
+}
+
+Napi::Value Pool::Close(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+
+  closed_ = true;
+  for (auto &deferred : waiters_) {
+    deferred.Reject(Napi::Error::New(env, "Pool is closed.").Value());
+  }
+  waiters_.clear();
+  if (warmup_) {
+    warmup_->Reject(Napi::Error::New(env, "Pool is closed.").Value());
+    warmup_.reset();
+  }
+  // Leased clients are dropped once they are released.
+  for (auto client : idle_) {
+    clients_.erase(client);
+  }
+  idle_.clear();
+  return env.Undefined();
+}
+
+Napi::Value Pool::Status(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+
+  Napi::Object status = Napi::Object::New(env);
+  status.Set("min", min_size_);
+  status.Set("max", max_size_);
+  status.Set("size", static_cast<uint32_t>(clients_.size()));
+  status.Set("idle", static_cast<uint32_t>(idle_.size()));
+  status.Set("leased", static_cast<uint32_t>(leased_.size()));
+  status.Set("opening", opening_);
+  status.Set("waiting", static_cast<uint32_t>(waiters_.size()));
+  return status;
+}
+
+Napi::Value Pool::Stats(const Napi::CallbackInfo &info) {
+  ClientStats stats;
+  for (const auto &entry : clients_) {
+    stats.Merge(*entry.first->Metrics());
+  }
+  return stats.ToNapiObject(info.Env());
+}
+
+Napi::Value Pool::ResetStats(const Napi::CallbackInfo &info) {
+  for (const auto &entry : clients_) {
+    entry.first->Metrics()->Reset();
+  }
+  return info.Env().Undefined();
+}
+
+}  // namespace nodemg
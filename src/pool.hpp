@@ -0,0 +1,78 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <napi.h>
+
+#include <deque>
+#include <mgclient.hpp>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "client.hpp"
+
+namespace nodemg {
+
+/// Pool owns a set of connected Clients and leases each one to at most one
+/// user at a time. All the bookkeeping happens on the main thread, only the
+/// connects are executed on the threadpool.
+class Pool final : public Napi::ObjectWrap<Pool> {
+ public:
+  static Napi::FunctionReference constructor;
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+
+  Pool(const Napi::CallbackInfo &info);
+  ~Pool();
+  // Public because they are called from AsyncWorker.
+  /// `warmup` is set for the initial connections opened by Connect.
+  void OnConnected(Napi::Object client, bool warmup);
+  void OnConnectFailed(const std::string &message, bool warmup);
+
+  Napi::Value Connect(const Napi::CallbackInfo &info);
+  Napi::Value Acquire(const Napi::CallbackInfo &info);
+  Napi::Value Release(const Napi::CallbackInfo &info);
+  Napi::Value Close(const Napi::CallbackInfo &info);
+  Napi::Value Status(const Napi::CallbackInfo &info);
+  /// The stats of the open connections merged together.
+  Napi::Value Stats(const Napi::CallbackInfo &info);
+  Napi::Value ResetStats(const Napi::CallbackInfo &info);
+
+ private:
+  std::string name_;
+  std::optional<mg::Client::Params> params_;
+  uint32_t min_size_;
+  uint32_t max_size_;
+  bool closed_;
+  // Applied to every connection, see ClientSettings.
+  ClientSettings settings_;
+  // Number of connects which are queued but not yet finished.
+  uint32_t opening_;
+  // Every open connection, idle or leased. Keeps the JS objects alive.
+  std::unordered_map<Client *, Napi::ObjectReference> clients_;
+  std::deque<Client *> idle_;
+  std::unordered_set<Client *> leased_;
+  // Acquire calls waiting for a connection, served in FIFO order.
+  std::deque<Napi::Promise::Deferred> waiters_;
+  // Pending Connect call, resolved once all initial connections are open.
+  std::optional<Napi::Promise::Deferred> warmup_;
+  uint32_t warmup_remaining_;
+
+  void OpenConnection(bool warmup = false);
+  void Lease(Client *client, const Napi::Promise::Deferred &deferred);
+  void Drop(Client *client);
+};
+
+}  // namespace nodemg
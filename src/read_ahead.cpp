@@ -0,0 +1,115 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "read_ahead.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace nodemg {
+
+ReadAheadBuffer::ReadAheadBuffer(size_t capacity) : slots_(capacity) {}
+
+size_t ReadAheadBuffer::Size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return size_;
+}
+
+bool ReadAheadBuffer::Full() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return size_ == slots_.size();
+}
+
+bool ReadAheadBuffer::Push(std::vector<mg::Value> &&record) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (size_ == slots_.size()) {
+    return false;
+  }
+  slots_[(head_ + size_) % slots_.size()] = std::move(record);
+  ++size_;
+  return true;
+}
+
+std::optional<std::vector<mg::Value>> ReadAheadBuffer::Pop() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (size_ == 0) {
+    return std::nullopt;
+  }
+  auto record = std::move(slots_[head_]);
+  slots_[head_].clear();
+  head_ = (head_ + 1) % slots_.size();
+  --size_;
+  return record;
+}
+
+std::vector<std::vector<mg::Value>> ReadAheadBuffer::TakeAll() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<std::vector<mg::Value>> records;
+  records.reserve(size_);
+  for (; size_ > 0; --size_) {
+    records.emplace_back(std::move(slots_[head_]));
+    slots_[head_].clear();
+    head_ = (head_ + 1) % slots_.size();
+  }
+  return records;
+}
+
+void ReadAheadBuffer::SetEnd(std::optional<std::string> error) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ended_ = true;
+  error_ = std::move(error);
+}
+
+bool ReadAheadBuffer::Ended() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return ended_;
+}
+
+bool ReadAheadBuffer::TakeEnd() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!ended_) {
+    return false;
+  }
+  ended_ = false;
+  if (error_) {
+    auto error = std::move(*error_);
+    error_.reset();
+    throw std::runtime_error(error);
+  }
+  return true;
+}
+
+void ReadAheadBuffer::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (; size_ > 0; --size_) {
+    slots_[head_].clear();
+    head_ = (head_ + 1) % slots_.size();
+  }
+  head_ = 0;
+  ended_ = false;
+  error_.reset();
+  fields_ = 0;
+}
+
+void ReadAheadBuffer::SetFields(size_t fields) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  fields_ = fields;
+}
+
+size_t ReadAheadBuffer::Fields() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return fields_;
+}
+
+}  // namespace nodemg
@@ -0,0 +1,79 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <mgclient.hpp>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace nodemg {
+
+/// Records of the current result fetched ahead of FetchOne, in a ring of a
+/// fixed capacity. The commands take these before reading from the
+/// connection, so the records keep their order whichever fetch call gets
+/// them. While no other command is queued, FetchOne takes a record right on
+/// the main thread, so a row-at-a-time consumer needs a worker hop only
+/// once per the capacity of records. Filled on the worker thread, the
+/// records and the end state may be taken on either thread. Also keeps the
+/// number of fields of the current result, which FetchColumns needs when
+/// there are no records.
+class ReadAheadBuffer {
+ public:
+  explicit ReadAheadBuffer(size_t capacity);
+
+  size_t Capacity() const { return slots_.size(); }
+  size_t Size() const;
+  bool Full() const;
+  /// Returns false if the buffer is full.
+  bool Push(std::vector<mg::Value> &&record);
+  std::optional<std::vector<mg::Value>> Pop();
+  std::vector<std::vector<mg::Value>> TakeAll();
+
+  /// The end of the result, or the error which ended it, was read ahead.
+  void SetEnd(std::optional<std::string> error = std::nullopt);
+  bool Ended() const;
+  /// Returns true once after SetEnd, throws the error passed to SetEnd.
+  bool TakeEnd();
+  /// Drops the records, the end state and the fields, e.g. when a new query
+  /// runs.
+  void Reset();
+  void SetFields(size_t fields);
+  size_t Fields() const;
+
+  // Main thread only.
+  /// Commands other than the read-ahead itself are queued, which has to
+  /// keep FetchOne from bypassing them.
+  void Hold() { ++holds_; }
+  void Unhold() { --holds_; }
+  bool Idle() const { return holds_ == 0; }
+  bool Refilling() const { return refilling_; }
+  void SetRefilling(bool refilling) { refilling_ = refilling; }
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<std::vector<mg::Value>> slots_;
+  size_t head_{0};
+  size_t size_{0};
+  bool ended_{false};
+  std::optional<std::string> error_;
+  size_t fields_{0};
+  size_t holds_{0};
+  bool refilling_{false};
+};
+
+}  // namespace nodemg
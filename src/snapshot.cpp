@@ -0,0 +1,233 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "snapshot.hpp"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace nodemg {
+
+// "MGS1" read as a little-endian u32.
+static constexpr uint32_t kSnapshotMagic = 0x3153474d;
+static constexpr size_t kHeaderSize = 4 * sizeof(uint32_t);
+
+// The values are copied in the host byte order, which is little-endian on
+// all the platforms the addon is built for.
+template <typename T>
+void SnapshotWriter::Put(T value) {
+  auto size = data_.size();
+  data_.resize(size + sizeof(T));
+  std::memcpy(data_.data() + size, &value, sizeof(T));
+}
+
+void SnapshotWriter::PutAt(size_t offset, uint32_t value) {
+  std::memcpy(data_.data() + offset, &value, sizeof(value));
+}
+
+uint32_t SnapshotWriter::Offset() const {
+  if (data_.size() > std::numeric_limits<uint32_t>::max()) {
+    throw std::length_error("The result is too large for a snapshot.");
+  }
+  return static_cast<uint32_t>(data_.size());
+}
+
+void SnapshotWriter::PutTag(SnapshotTag tag) {
+  Put(static_cast<uint8_t>(tag));
+}
+
+void SnapshotWriter::PutString(const mg_string *value) {
+  std::string_view key(mg_string_data(value), mg_string_size(value));
+  auto it = string_index_.find(key);
+  if (it != string_index_.end()) {
+    Put(it->second);
+    return;
+  }
+  auto index = static_cast<uint32_t>(strings_.size());
+  strings_.push_back(key);
+  string_index_.emplace(key, index);
+  Put(index);
+}
+
+void SnapshotWriter::PutMap(const mg_map *value) {
+  auto size = mg_map_size(value);
+  Put(size);
+  for (uint32_t index = 0; index < size; ++index) {
+    PutString(mg_map_key_at(value, index));
+    PutValue(mg_map_value_at(value, index));
+  }
+}
+
+void SnapshotWriter::PutNode(const mg_node *value) {
+  Put(mg_node_id(value));
+  auto label_count = mg_node_label_count(value);
+  Put(label_count);
+  for (uint32_t index = 0; index < label_count; ++index) {
+    PutString(mg_node_label_at(value, index));
+  }
+  PutMap(mg_node_properties(value));
+}
+
+void SnapshotWriter::PutUnboundRelationship(
+    const mg_unbound_relationship *value) {
+  Put(mg_unbound_relationship_id(value));
+  PutString(mg_unbound_relationship_type(value));
+  PutMap(mg_unbound_relationship_properties(value));
+}
+
+void SnapshotWriter::PutValue(const mg_value *value) {
+  switch (mg_value_get_type(value)) {
+    case MG_VALUE_TYPE_NULL:
+      PutTag(SnapshotTag::Null);
+      return;
+    case MG_VALUE_TYPE_BOOL:
+      PutTag(mg_value_bool(value) ? SnapshotTag::True : SnapshotTag::False);
+      return;
+    case MG_VALUE_TYPE_INTEGER:
+      PutTag(SnapshotTag::Integer);
+      Put(mg_value_integer(value));
+      return;
+    case MG_VALUE_TYPE_FLOAT:
+      PutTag(SnapshotTag::Float);
+      Put(mg_value_float(value));
+      return;
+    case MG_VALUE_TYPE_STRING:
+      PutTag(SnapshotTag::String);
+      PutString(mg_value_string(value));
+      return;
+    case MG_VALUE_TYPE_LIST: {
+      PutTag(SnapshotTag::List);
+      const auto *list = mg_value_list(value);
+      auto size = mg_list_size(list);
+      Put(size);
+      for (uint32_t index = 0; index < size; ++index) {
+        PutValue(mg_list_at(list, index));
+      }
+      return;
+    }
+    case MG_VALUE_TYPE_MAP:
+      PutTag(SnapshotTag::Map);
+      PutMap(mg_value_map(value));
+      return;
+    case MG_VALUE_TYPE_NODE:
+      PutTag(SnapshotTag::Node);
+      PutNode(mg_value_node(value));
+      return;
+    case MG_VALUE_TYPE_RELATIONSHIP: {
+      PutTag(SnapshotTag::Relationship);
+      const auto *relationship = mg_value_relationship(value);
+      Put(mg_relationship_id(relationship));
+      Put(mg_relationship_start_id(relationship));
+      Put(mg_relationship_end_id(relationship));
+      PutString(mg_relationship_type(relationship));
+      PutMap(mg_relationship_properties(relationship));
+      return;
+    }
+    case MG_VALUE_TYPE_UNBOUND_RELATIONSHIP:
+      PutTag(SnapshotTag::UnboundRelationship);
+      PutUnboundRelationship(mg_value_unbound_relationship(value));
+      return;
+    case MG_VALUE_TYPE_PATH: {
+      PutTag(SnapshotTag::Path);
+      const auto *path = mg_value_path(value);
+      auto length = mg_path_length(path);
+      Put(length);
+      for (uint32_t index = 0; index <= length; ++index) {
+        PutNode(mg_path_node_at(path, index));
+      }
+      for (uint32_t index = 0; index < length; ++index) {
+        Put(static_cast<uint8_t>(
+            mg_path_relationship_reversed_at(path, index) ? 1 : 0));
+        PutUnboundRelationship(mg_path_relationship_at(path, index));
+      }
+      return;
+    }
+    case MG_VALUE_TYPE_DATE:
+      PutTag(SnapshotTag::Date);
+      Put(mg_date_days(mg_value_date(value)));
+      return;
+    case MG_VALUE_TYPE_LOCAL_TIME:
+      PutTag(SnapshotTag::LocalTime);
+      Put(mg_local_time_nanoseconds(mg_value_local_time(value)));
+      return;
+    case MG_VALUE_TYPE_LOCAL_DATE_TIME: {
+      PutTag(SnapshotTag::LocalDateTime);
+      const auto *local_date_time = mg_value_local_date_time(value);
+      Put(mg_local_date_time_seconds(local_date_time));
+      Put(mg_local_date_time_nanoseconds(local_date_time));
+      return;
+    }
+    case MG_VALUE_TYPE_DURATION: {
+      PutTag(SnapshotTag::Duration);
+      const auto *duration = mg_value_duration(value);
+      Put(mg_duration_days(duration));
+      Put(mg_duration_seconds(duration));
+      Put(mg_duration_nanoseconds(duration));
+      return;
+    }
+    default:
+      throw std::invalid_argument(
+          "A value of unknown type can't be added to a snapshot.");
+  }
+}
+
+void SnapshotWriter::PutStrings() {
+  auto table_offset = Offset();
+  data_.resize(data_.size() + (strings_.size() + 1) * sizeof(uint32_t));
+  uint64_t string_offset = 0;
+  for (size_t index = 0; index < strings_.size(); ++index) {
+    PutAt(table_offset + index * sizeof(uint32_t),
+          static_cast<uint32_t>(string_offset));
+    string_offset += strings_[index].size();
+  }
+  PutAt(table_offset + strings_.size() * sizeof(uint32_t),
+        static_cast<uint32_t>(string_offset));
+  auto bytes_offset = data_.size();
+  data_.resize(bytes_offset + string_offset);
+  Offset();
+  for (const auto &value : strings_) {
+    std::memcpy(data_.data() + bytes_offset, value.data(), value.size());
+    bytes_offset += value.size();
+  }
+}
+
+std::vector<uint8_t> SnapshotWriter::Write(
+    const std::vector<std::vector<mg::Value>> &records) {
+  data_.clear();
+  strings_.clear();
+  string_index_.clear();
+
+  data_.resize(kHeaderSize + records.size() * sizeof(uint32_t));
+  PutAt(0, kSnapshotMagic);
+  PutAt(4, static_cast<uint32_t>(records.size()));
+  for (size_t row = 0; row < records.size(); ++row) {
+    PutAt(kHeaderSize + row * sizeof(uint32_t), Offset());
+    const auto &record = records[row];
+    auto cell_count = static_cast<uint32_t>(record.size());
+    Put(cell_count);
+    auto cell_table = data_.size();
+    data_.resize(cell_table + record.size() * sizeof(uint32_t));
+    for (size_t cell = 0; cell < record.size(); ++cell) {
+      PutAt(cell_table + cell * sizeof(uint32_t), Offset());
+      PutValue(record[cell].ptr());
+    }
+  }
+  PutAt(8, static_cast<uint32_t>(strings_.size()));
+  PutAt(12, Offset());
+  PutStrings();
+  return std::move(data_);
+}
+
+}  // namespace nodemg
@@ -0,0 +1,106 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <mgclient.h>
+
+#include <cstdint>
+#include <mgclient.hpp>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace nodemg {
+
+// Records serialized into a single flat buffer which is decoded lazily by
+// lib/snapshot.js. The layout (all numbers little-endian, offsets are u32
+// byte offsets from the start of the buffer):
+//
+//   header:  u32 magic "MGS1", u32 row count, u32 string count,
+//            u32 string table offset
+//   rows:    u32 offset of every row
+//   row:     u32 cell count, u32 offset of every cell, cells
+//   strings: u32 offset of every string plus the end offset, relative to
+//            the first string byte, followed by the UTF-8 bytes
+//
+// Every cell is a tagged value, see SnapshotTag. Strings, keys, labels and
+// edge types are deduplicated and referenced by their u32 index.
+//
+// NOTE: Must be kept in sync with lib/snapshot.js.
+enum class SnapshotTag : uint8_t {
+  Null = 0,
+  False = 1,
+  True = 2,
+  // i64
+  Integer = 3,
+  // f64
+  Float = 4,
+  // u32 string index
+  String = 5,
+  // u32 count, values
+  List = 6,
+  // u32 count, (u32 key index, value) pairs
+  Map = 7,
+  // i64 id, u32 label count, u32 label indices, map
+  Node = 8,
+  // i64 id, i64 start id, i64 end id, u32 type index, map
+  Relationship = 9,
+  // i64 id, u32 type index, map
+  UnboundRelationship = 10,
+  // u32 relationship count n, n + 1 nodes, n times (u8 reversed, unbound)
+  Path = 11,
+  // i64 days
+  Date = 12,
+  // i64 nanoseconds
+  LocalTime = 13,
+  // i64 seconds, i64 nanoseconds
+  LocalDateTime = 14,
+  // i64 days, i64 seconds, i64 nanoseconds
+  Duration = 15,
+};
+
+/// Serializes records on the worker thread. The writer doesn't touch N-API,
+/// the JS side receives one ArrayBuffer instead of a tree of values.
+class SnapshotWriter {
+ public:
+  /// Writes into the given buffer, e.g. a recycled one, if it has enough
+  /// capacity.
+  explicit SnapshotWriter(std::vector<uint8_t> buffer = {})
+      : data_(std::move(buffer)) {}
+
+  /// Throws std::length_error if the result doesn't fit the u32 offsets.
+  std::vector<uint8_t> Write(
+      const std::vector<std::vector<mg::Value>> &records);
+
+ private:
+  std::vector<uint8_t> data_;
+  // The views point into the records, which outlive the writer.
+  std::vector<std::string_view> strings_;
+  std::unordered_map<std::string_view, uint32_t> string_index_;
+
+  template <typename T>
+  void Put(T value);
+  void PutAt(size_t offset, uint32_t value);
+  uint32_t Offset() const;
+  void PutTag(SnapshotTag tag);
+  void PutString(const mg_string *value);
+  void PutValue(const mg_value *value);
+  void PutMap(const mg_map *value);
+  void PutNode(const mg_node *value);
+  void PutUnboundRelationship(const mg_unbound_relationship *value);
+  void PutStrings();
+};
+
+}  // namespace nodemg
@@ -0,0 +1,190 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "statement.hpp"
+
+#include "util.hpp"
+
+namespace nodemg {
+
+Napi::FunctionReference Statement::constructor;
+
+Napi::Object Statement::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  // The class isn't exported, statements are created by Client.Prepare.
+  Napi::Function func = DefineClass(
+      env, "Statement",
+      {
+          InstanceAccessor("query", &Statement::QueryText, nullptr,
+                           napi_enumerable),
+          InstanceMethod("Execute", &Statement::Execute),
+          InstanceMethod("ExecuteAndFetchAll", &Statement::ExecuteAndFetchAll),
+          InstanceMethod("ExecuteAndDiscardAll",
+                         &Statement::ExecuteAndDiscardAll),
+      });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  return exports;
+}
+
+Napi::Value Statement::New(Napi::Env env, Client *client,
+                           Napi::Object client_object, Napi::String query) {
+  return constructor.New(
+      {Napi::External<Client>::New(env, client), client_object, query});
+}
+
+Statement::Statement(const Napi::CallbackInfo &info)
+    : Napi::ObjectWrap<Statement>(info), client_(nullptr) {
+  auto env = info.Env();
+  if (info.Length() != 3 || !info[0].IsExternal() || !info[1].IsObject() ||
+      !info[2].IsString()) {
+    NODEMG_THROW("Statements are created only by Client.Prepare.");
+    return;
+  }
+  client_ = info[0].As<Napi::External<Client>>().Data();
+  client_ref_ = Napi::Persistent(info[1].As<Napi::Object>());
+  query_ = std::make_shared<const std::string>(
+      info[2].As<Napi::String>().Utf8Value());
+}
+
+Napi::Value Statement::QueryText(const Napi::CallbackInfo &info) {
+  return Napi::String::New(info.Env(), *query_);
+}
+
+bool Statement::CacheKeys(Napi::Env env, Napi::Array keys) {
+  auto mg_keys = std::make_shared<ParamKeys>();
+  mg_keys->reserve(keys.Length());
+  for (uint32_t index = 0; index < keys.Length(); ++index) {
+    Napi::Value key = keys[index];
+    MgStringPtr mg_key(NapiStringToMgString(key.As<Napi::String>()));
+    if (!mg_key) {
+      NODEMG_THROW("Fail to construct Memgraph string.");
+      return false;
+    }
+    mg_keys->push_back(std::move(mg_key));
+  }
+  keys_ = Napi::Persistent(keys);
+  mg_keys_ = std::move(mg_keys);
+  return true;
+}
+
+// Writes the values of the cached keys. Returns false if the params don't
+// have the cached keys.
+std::optional<bool> Statement::PutCachedParams(ParamWriter &writer,
+                                               Napi::Object params) {
+  auto keys = keys_.Value().As<Napi::Array>();
+  for (uint32_t index = 0; index < keys.Length(); ++index) {
+    Napi::Value key = keys[index];
+    auto value = params.Get(key);
+    if (value.IsUndefined() && !params.Has(key)) {
+      return false;
+    }
+    if (!writer.PutValue(value)) {
+      return std::nullopt;
+    }
+  }
+  return true;
+}
+
+std::optional<ParamSnapshot> Statement::SnapshotParams(Napi::Env env,
+                                                       Napi::Object params) {
+  // The cached keys are probed directly, the keys of the params are listed
+  // only when one of them is missing.
+  if (mg_keys_) {
+    ParamWriter writer(env, client_->Arenas());
+    auto matched = PutCachedParams(writer, params);
+    if (!matched) {
+      return std::nullopt;
+    }
+    if (*matched) {
+      return writer.Finish(mg_keys_);
+    }
+  }
+  if (!CacheKeys(env, params.GetPropertyNames())) {
+    return std::nullopt;
+  }
+  ParamWriter writer(env, client_->Arenas());
+  auto matched = PutCachedParams(writer, params);
+  if (!matched) {
+    return std::nullopt;
+  }
+  if (!*matched) {
+    NODEMG_THROW("The query parameters changed while being converted.");
+    return std::nullopt;
+  }
+  return writer.Finish(mg_keys_);
+}
+
+std::optional<Query> Statement::PrepareQuery(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+
+  ParamSnapshot query_params;
+  if (info.Length() >= 1 && !info[0].IsUndefined()) {
+    if (!info[0].IsObject()) {
+      NODEMG_THROW(
+          "The first execute argument has to be an object containing query "
+          "parameters.");
+      return std::nullopt;
+    }
+    auto start = StatsClock::now();
+    auto maybe_params = SnapshotParams(env, info[0].As<Napi::Object>());
+    client_->Metrics()->encoding.Record(ElapsedNanoseconds(start));
+    if (!maybe_params) {
+      return std::nullopt;
+    }
+    query_params = std::move(*maybe_params);
+  }
+
+  return Query{query_, std::move(query_params)};
+}
+
+Napi::Value Statement::Execute(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  auto query = PrepareQuery(info);
+  if (!query) {
+    return env.Undefined();
+  }
+  return client_->EnqueueQuery(env, std::move(*query),
+                               Client::ResultMode::Keep, DecodeOptions());
+}
+
+Napi::Value Statement::ExecuteAndFetchAll(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  auto query = PrepareQuery(info);
+  if (!query) {
+    return env.Undefined();
+  }
+  auto options = client_->PrepareDecodeOptions(info, 1);
+  if (!options) {
+    return env.Undefined();
+  }
+  return client_->EnqueueQuery(env, std::move(*query),
+                               Client::ResultMode::FetchAll, *options);
+}
+
+Napi::Value Statement::ExecuteAndDiscardAll(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  auto query = PrepareQuery(info);
+  if (!query) {
+    return env.Undefined();
+  }
+  return client_->EnqueueQuery(env, std::move(*query),
+                               Client::ResultMode::DiscardAll,
+                               DecodeOptions());
+}
+
+}  // namespace nodemg
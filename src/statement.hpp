@@ -0,0 +1,70 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <napi.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "client.hpp"
+#include "glue.hpp"
+#include "params.hpp"
+
+namespace nodemg {
+
+// A query prepared by Client.Prepare. The UTF-8 query text is encoded once
+// and shared by all executions. The keys of the first parameters object are
+// cached as JS strings and as prebuilt mg_strings, so the following calls
+// only look the cached keys up and snapshot their values. If one of them is
+// missing, the cache is rebuilt from the keys of the params. Keys beyond the
+// cached ones aren't looked for, so they aren't sent.
+//
+// NOTE: mgclient takes the ownership of the map keys, every execution gets
+// its own copy of the prebuilt keys (a memcpy on the worker thread, no UTF-8
+// conversion).
+class Statement final : public Napi::ObjectWrap<Statement> {
+ public:
+  static Napi::FunctionReference constructor;
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static Napi::Value New(Napi::Env env, Client *client,
+                         Napi::Object client_object, Napi::String query);
+
+  Statement(const Napi::CallbackInfo &info);
+
+  Napi::Value QueryText(const Napi::CallbackInfo &info);
+  Napi::Value Execute(const Napi::CallbackInfo &info);
+  Napi::Value ExecuteAndFetchAll(const Napi::CallbackInfo &info);
+  Napi::Value ExecuteAndDiscardAll(const Napi::CallbackInfo &info);
+
+ private:
+  Client *client_;
+  // Keeps the client alive for as long as the statement is.
+  Napi::ObjectReference client_ref_;
+  std::shared_ptr<const std::string> query_;
+  Napi::ObjectReference keys_;
+  // Shared with the snapshots of the queued executions.
+  std::shared_ptr<const ParamKeys> mg_keys_;
+
+  std::optional<Query> PrepareQuery(const Napi::CallbackInfo &info);
+  std::optional<ParamSnapshot> SnapshotParams(Napi::Env env,
+                                              Napi::Object params);
+  std::optional<bool> PutCachedParams(ParamWriter &writer,
+                                      Napi::Object params);
+  bool CacheKeys(Napi::Env env, Napi::Array keys);
+};
+
+}  // namespace nodemg
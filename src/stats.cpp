@@ -0,0 +1,186 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "stats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace nodemg {
+
+static constexpr auto kRelaxed = std::memory_order_relaxed;
+
+uint64_t ElapsedNanoseconds(StatsClock::time_point start) {
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     StatsClock::now() - start)
+                     .count();
+  return elapsed > 0 ? static_cast<uint64_t>(elapsed) : 0;
+}
+
+static void StoreMin(std::atomic<uint64_t> &target, uint64_t value) {
+  auto current = target.load(kRelaxed);
+  while (value < current &&
+         !target.compare_exchange_weak(current, value, kRelaxed)) {
+  }
+}
+
+static void StoreMax(std::atomic<uint64_t> &target, uint64_t value) {
+  auto current = target.load(kRelaxed);
+  while (value > current &&
+         !target.compare_exchange_weak(current, value, kRelaxed)) {
+  }
+}
+
+Histogram::Histogram() { Reset(); }
+
+size_t Histogram::BucketIndex(uint64_t value) {
+  if (value < kSubBuckets) {
+    return value;
+  }
+  unsigned exponent = kSubBucketBits;
+  while (exponent < 63 && (value >> (exponent + 1)) != 0) {
+    ++exponent;
+  }
+  if (exponent > kMaxExponent) {
+    return kBucketCount - 1;
+  }
+  auto sub_bucket =
+      (value >> (exponent - kSubBucketBits)) & (kSubBuckets - 1);
+  return (exponent - kSubBucketBits + 1) * kSubBuckets + sub_bucket;
+}
+
+uint64_t Histogram::BucketValue(size_t index) {
+  if (index < kSubBuckets) {
+    return index;
+  }
+  auto shift = index / kSubBuckets - 1;
+  uint64_t lower = (kSubBuckets + index % kSubBuckets) << shift;
+  return lower + (uint64_t{1} << shift) - 1;
+}
+
+void Histogram::Record(uint64_t nanoseconds) {
+  counts_[BucketIndex(nanoseconds)].fetch_add(1, kRelaxed);
+  count_.fetch_add(1, kRelaxed);
+  sum_.fetch_add(nanoseconds, kRelaxed);
+  StoreMin(min_, nanoseconds);
+  StoreMax(max_, nanoseconds);
+}
+
+void Histogram::Merge(const Histogram &other) {
+  for (size_t index = 0; index < kBucketCount; ++index) {
+    counts_[index].fetch_add(other.counts_[index].load(kRelaxed), kRelaxed);
+  }
+  count_.fetch_add(other.count_.load(kRelaxed), kRelaxed);
+  sum_.fetch_add(other.sum_.load(kRelaxed), kRelaxed);
+  StoreMin(min_, other.min_.load(kRelaxed));
+  StoreMax(max_, other.max_.load(kRelaxed));
+}
+
+void Histogram::Reset() {
+  for (auto &count : counts_) {
+    count.store(0, kRelaxed);
+  }
+  count_.store(0, kRelaxed);
+  sum_.store(0, kRelaxed);
+  min_.store(std::numeric_limits<uint64_t>::max(), kRelaxed);
+  max_.store(0, kRelaxed);
+}
+
+uint64_t Histogram::Percentile(double fraction) const {
+  auto count = count_.load(kRelaxed);
+  auto rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(
+             std::ceil(fraction * static_cast<double>(count))));
+  auto min = min_.load(kRelaxed);
+  auto max = max_.load(kRelaxed);
+  uint64_t seen = 0;
+  for (size_t index = 0; index < kBucketCount; ++index) {
+    seen += counts_[index].load(kRelaxed);
+    if (seen >= rank) {
+      return std::clamp(BucketValue(index), min, max);
+    }
+  }
+  // A concurrent Record has bumped the count before its bucket.
+  return max;
+}
+
+static double ToMilliseconds(uint64_t nanoseconds) {
+  return static_cast<double>(nanoseconds) / 1e6;
+}
+
+Napi::Object Histogram::ToNapiObject(Napi::Env env) const {
+  auto output = Napi::Object::New(env);
+  auto count = count_.load(kRelaxed);
+  output.Set("count", static_cast<double>(count));
+  if (count == 0) {
+    for (const auto *key :
+         {"min", "mean", "p50", "p90", "p99", "p999", "max"}) {
+      output.Set(key, 0.0);
+    }
+    return output;
+  }
+  output.Set("min", ToMilliseconds(min_.load(kRelaxed)));
+  output.Set("mean", ToMilliseconds(sum_.load(kRelaxed)) /
+                         static_cast<double>(count));
+  output.Set("p50", ToMilliseconds(Percentile(0.5)));
+  output.Set("p90", ToMilliseconds(Percentile(0.9)));
+  output.Set("p99", ToMilliseconds(Percentile(0.99)));
+  output.Set("p999", ToMilliseconds(Percentile(0.999)));
+  output.Set("max", ToMilliseconds(max_.load(kRelaxed)));
+  return output;
+}
+
+void ClientStats::Merge(const ClientStats &other) {
+  queue_wait.Merge(other.queue_wait);
+  threadpool_wait.Merge(other.threadpool_wait);
+  network.Merge(other.network);
+  encoding.Merge(other.encoding);
+  conversion.Merge(other.conversion);
+  queries.fetch_add(other.queries.load(kRelaxed), kRelaxed);
+  commands.fetch_add(other.commands.load(kRelaxed), kRelaxed);
+  errors.fetch_add(other.errors.load(kRelaxed), kRelaxed);
+  rows.fetch_add(other.rows.load(kRelaxed), kRelaxed);
+  bytes.fetch_add(other.bytes.load(kRelaxed), kRelaxed);
+}
+
+void ClientStats::Reset() {
+  queue_wait.Reset();
+  threadpool_wait.Reset();
+  network.Reset();
+  encoding.Reset();
+  conversion.Reset();
+  queries.store(0, kRelaxed);
+  commands.store(0, kRelaxed);
+  errors.store(0, kRelaxed);
+  rows.store(0, kRelaxed);
+  bytes.store(0, kRelaxed);
+}
+
+Napi::Object ClientStats::ToNapiObject(Napi::Env env) const {
+  auto output = Napi::Object::New(env);
+  output.Set("queries", static_cast<double>(queries.load(kRelaxed)));
+  output.Set("commands", static_cast<double>(commands.load(kRelaxed)));
+  output.Set("errors", static_cast<double>(errors.load(kRelaxed)));
+  output.Set("rows", static_cast<double>(rows.load(kRelaxed)));
+  output.Set("bytes", static_cast<double>(bytes.load(kRelaxed)));
+  output.Set("queueWait", queue_wait.ToNapiObject(env));
+  output.Set("threadpoolWait", threadpool_wait.ToNapiObject(env));
+  output.Set("network", network.ToNapiObject(env));
+  output.Set("encoding", encoding.ToNapiObject(env));
+  output.Set("conversion", conversion.ToNapiObject(env));
+  return output;
+}
+
+}  // namespace nodemg
@@ -0,0 +1,98 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <napi.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace nodemg {
+
+using StatsClock = std::chrono::steady_clock;
+
+/// Nanoseconds passed since start.
+uint64_t ElapsedNanoseconds(StatsClock::time_point start);
+
+/// Log-linear histogram of durations in nanoseconds, in the style of
+/// HdrHistogram: every power of two range is split into 16 linear buckets,
+/// so a reported percentile is off by at most 1/16 of the value. Recording
+/// is a handful of relaxed atomic operations, the worker threads and the main
+/// thread record without a lock. Reading while recording gives a slightly
+/// inconsistent, but never invalid, view.
+class Histogram {
+ public:
+  Histogram();
+
+  void Record(uint64_t nanoseconds);
+  void Merge(const Histogram &other);
+  void Reset();
+  /// `{ count, min, mean, p50, p90, p99, p999, max }`, in milliseconds.
+  Napi::Object ToNapiObject(Napi::Env env) const;
+
+ private:
+  static constexpr unsigned kSubBucketBits = 4;
+  static constexpr size_t kSubBuckets = size_t{1} << kSubBucketBits;
+  // Durations above 2^40 ns (about 18 minutes) land in the last bucket.
+  static constexpr unsigned kMaxExponent = 40;
+  // The values below kSubBuckets are exact, then one group of kSubBuckets
+  // buckets per power of two.
+  static constexpr size_t kBucketCount =
+      (kMaxExponent - kSubBucketBits + 2) * kSubBuckets;
+
+  static size_t BucketIndex(uint64_t value);
+  // The highest value which falls into the bucket.
+  static uint64_t BucketValue(size_t index);
+  uint64_t Percentile(double fraction) const;
+
+  std::array<std::atomic<uint64_t>, kBucketCount> counts_;
+  std::atomic<uint64_t> count_;
+  std::atomic<uint64_t> sum_;
+  std::atomic<uint64_t> min_;
+  std::atomic<uint64_t> max_;
+};
+
+/// Counters and per-phase latencies of one client. Shared by the Client and
+/// its workers, so it's safe to record from any thread.
+struct ClientStats {
+  // From the call until its batch is handed to the threadpool, i.e. the
+  // wait behind the previous batch of the same client.
+  Histogram queue_wait;
+  // From the batch being queued until a threadpool thread picks it up. Grows
+  // when UV_THREADPOOL_SIZE is too small for the load.
+  Histogram threadpool_wait;
+  // Command execution on the worker thread: the round trips to the server
+  // and the decoding of the received messages.
+  Histogram network;
+  // Parameter snapshot on the main thread.
+  Histogram encoding;
+  // Result conversion into JS values on the main thread.
+  Histogram conversion;
+  std::atomic<uint64_t> queries{0};
+  std::atomic<uint64_t> commands{0};
+  std::atomic<uint64_t> errors{0};
+  std::atomic<uint64_t> rows{0};
+  // The payload size of the received records, see MgValuePayloadBytes.
+  std::atomic<uint64_t> bytes{0};
+
+  void Merge(const ClientStats &other);
+  void Reset();
+  Napi::Object ToNapiObject(Napi::Env env) const;
+};
+
+}  // namespace nodemg
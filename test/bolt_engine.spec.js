@@ -0,0 +1,212 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+const memgraph = require('..');
+const { Dechunker, chunk } = require('../lib/packstream');
+const util = require('./util');
+
+function connect(port) {
+  return memgraph.Connect({ host: '127.0.0.1', port: port,
+    event_loop: true });
+}
+
+test('Event loop engine converts results like the native client', async () => {
+  await util.checkAgainstBoltServer({
+    results: {
+      'MATCH (n) RETURN n;': { shape: 'node', rows: 3 },
+      'MATCH p RETURN p;': { shape: 'path', rows: 1 },
+      'RETURN $x;': { fields: ['x'], records: [[42n], [[1.5, 2.5]]] },
+    },
+  }, async (port) => {
+    const connection = await connect(port);
+    const nodes = await connection.ExecuteAndFetchAll('MATCH (n) RETURN n;');
+    expect(nodes[2][0]).toEqual({
+      objectType: 'node',
+      id: 2n,
+      labels: ['Person'],
+      properties: { id: 2n, name: 'name2' },
+    });
+    const [[path]] = await connection.ExecuteAndFetchAll('MATCH p RETURN p;',
+      {}, { integers: 'number' });
+    expect(path.nodes.length).toEqual(11);
+    expect(path.relationships[3]).toEqual({
+      objectType: 'relationship',
+      id: 3,
+      startNodeId: 3,
+      endNodeId: 4,
+      edgeType: 'NEXT',
+      properties: {},
+    });
+    expect(await connection.ExecuteAndFetchAll('RETURN $x;', { x: 1n },
+      { typedLists: true })).toEqual([[42n], [new Float64Array([1.5, 2.5])]]);
+    expect(() => connection.client.Execute('RETURN $x;', { x: 2n ** 64n }))
+      .toThrow('Fail to losslessly convert value to Memgraph int64.');
+    connection.Close();
+  });
+});
+
+test('Event loop engine recovers from failures', async () => {
+  await util.checkAgainstBoltServer({
+    results: {
+      'FAIL;': { error: { message: 'Scripted failure.' } },
+    },
+    defaultResult: { shape: 'scalar', rows: 5 },
+  }, async (port, server) => {
+    const connection = await connect(port);
+    await expect(connection.ExecuteAndFetchAll('FAIL;'))
+      .rejects.toThrow('Failed to execute a query. Scripted failure.');
+    await connection.Begin();
+    expect((await connection.ExecuteAndFetchAll('UNKNOWN;')).length)
+      .toEqual(5);
+    await connection.Commit();
+    expect(server.stats.messages.RESET).toEqual(1);
+    connection.Close();
+  });
+});
+
+test('Event loop engine streams and pipelines calls', async () => {
+  await util.checkAgainstBoltServer({
+    defaultResult: { shape: 'scalar', rows: 25000 },
+  }, async (port) => {
+    const connection = await connect(port);
+    await connection.Execute('UNWIND range(0, 24999) AS n RETURN n;');
+    expect(await connection.client.FetchOne()).toEqual([0n]);
+    expect((await connection.FetchAll()).length).toEqual(24999);
+    // Concurrent calls run one after another.
+    const results = await Promise.all([1, 2, 3].map(() =>
+      connection.ExecuteAndFetchAll('RETURN 1;')));
+    expect(results.map((result) => result.length))
+      .toEqual([25000, 25000, 25000]);
+    const stats = connection.Stats();
+    expect(stats.queries).toEqual(4);
+    expect(stats.threadpoolWait.count).toEqual(0);
+    connection.Close();
+    await expect(connection.ExecuteAndFetchAll('RETURN 1;')).rejects
+      .toThrow('Client is not connected.');
+  });
+});
+
+test('Event loop engine converts large results in time slices', async () => {
+  await util.checkAgainstBoltServer({
+    defaultResult: { shape: 'wide', rows: 50000 },
+  }, async (port) => {
+    const connection = await connect(port);
+    const expected = await connection.ExecuteAndFetchAll('RETURN 1;');
+    let turns = 0;
+    const ticker = setInterval(() => ++turns, 0);
+    connection.ResetStats();
+    const sliced = await connection.ExecuteAndFetchAll('RETURN 1;', {},
+      { timeSlice: 200 });
+    clearInterval(ticker);
+    expect(sliced).toEqual(expected);
+    expect(turns).toBeGreaterThan(0);
+    expect(connection.Stats().conversion.count).toBeGreaterThan(1);
+    connection.Close();
+  });
+});
+
+test('Event loop engine streams records with backpressure', async () => {
+  await util.checkAgainstBoltServer({
+    defaultResult: { shape: 'scalar', rows: 2500 },
+  }, async (port) => {
+    const connection = await connect(port);
+    const stream = connection.Stream('RETURN 1;', {}, { highWaterMark: 100,
+      integers: 'number' });
+    const records = [];
+    for await (const record of stream) {
+      records.push(record);
+    }
+    expect(records.length).toEqual(2500);
+    expect(records[2499]).toEqual([2499]);
+    // A stream which stops early leaves the connection usable.
+    const early = connection.Stream('RETURN 1;', {}, { highWaterMark: 10 });
+    for await (const record of early) {
+      expect(record).toEqual([0n]);
+      break;
+    }
+    expect((await connection.ExecuteAndFetchAll('RETURN 1;')).length)
+      .toEqual(2500);
+    connection.Close();
+  });
+});
+
+test('Event loop engine executes many queries in one call', async () => {
+  await util.checkAgainstBoltServer({
+    handler: (query, params) => query === 'FAIL;' ?
+      { error: { message: 'Scripted failure.' } } :
+      { fields: ['id'], records: [[params.id]] },
+  }, async (port, server) => {
+    const connection = await connect(port);
+    expect(() => connection.client.ExecuteMany([{ query: 'RETURN 1;',
+      params: null }])).toThrow(
+      'ExecuteMany requires an array of { query, params } objects.');
+    const statements = [1, 2].map((id) =>
+      ({ query: 'RETURN $id;', params: { id: BigInt(id) } }));
+    const results = await connection.ExecuteMany(
+      [statements[0], { query: 'FAIL;' }, statements[1]]);
+    expect(results[0]).toEqual({ records: [[1n]] });
+    expect(results[1].error.message).toMatch('Scripted failure.');
+    expect(results[2]).toEqual({ records: [[2n]] });
+    const transaction = await connection.ExecuteMany(
+      [{ query: 'FAIL;' }, statements[0]],
+      { transactional: true, integers: 'number' });
+    expect(transaction[1].error.message).toEqual(
+      'Not executed, the transaction was rolled back.');
+    expect(await connection.ExecuteMany(statements,
+      { transactional: true, integers: 'number' }))
+      .toEqual([{ records: [[1]] }, { records: [[2]] }]);
+    expect(server.stats.messages.BEGIN).toEqual(2);
+    expect(connection.Stats().commands).toEqual(3);
+    connection.Close();
+  });
+});
+
+test('Event loop engine pipelines and retries transactions', async () => {
+  let conflicts = 0;
+  await util.checkAgainstBoltServer({
+    handler: (query) => {
+      if (query === 'CONFLICT;' && conflicts-- > 0) {
+        return { error: {
+          code: 'Memgraph.TransientError.MemgraphError.MemgraphError',
+          message: 'Retry later.',
+        } };
+      }
+      return query === 'FAIL;' ? { error: { message: 'Scripted failure.' } } :
+        { shape: 'scalar', rows: 2 };
+    },
+  }, async (port, server) => {
+    const connection = await connect(port);
+    conflicts = 2;
+    const statements = [{ query: 'CONFLICT;' }, { query: 'RETURN 1;' }];
+    expect(await connection.Transaction(statements,
+      { retryDelay: 1, integers: 'number' })).toEqual([[[0], [1]], [[0], [1]]]);
+    expect(server.stats.messages.BEGIN).toEqual(3);
+    expect(connection.Stats().commands).toEqual(3);
+
+    conflicts = 5;
+    await expect(connection.Transaction(statements, { retries: 1,
+      retryDelay: 1 })).rejects.toThrow('Retry later.');
+    await expect(connection.Transaction([{ query: 'FAIL;' }],
+      { retryDelay: 1 })).rejects.toThrow('Scripted failure.');
+    expect(server.stats.messages.BEGIN).toEqual(6);
+  });
+});
+
+test('Event loop engine skips NOOP chunks between messages', () => {
+  const dechunker = new Dechunker();
+  const message = Buffer.from([0xb0, 0x70]);
+  const noop = Buffer.alloc(2);
+  expect(dechunker.push(Buffer.concat([noop, chunk(message), noop,
+    chunk(message)]))).toEqual([message, message]);
+});
@@ -0,0 +1,366 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+const memgraph = require('..');
+const util = require('./util');
+
+test('Bolt server replays scripted results', async () => {
+  await util.checkAgainstBoltServer({
+    results: {
+      'MATCH (n) RETURN n;': { shape: 'node', rows: 3 },
+      'RETURN $x;': { fields: ['x'], records: [[42n], ['text']] },
+      'FAIL;': { error: { message: 'Scripted failure.' } },
+    },
+  }, async (port, server) => {
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+    });
+    expect(connection).toBeDefined();
+
+    const nodes = await connection.ExecuteAndFetchAll('MATCH (n) RETURN n;');
+    expect(nodes.length).toEqual(3);
+    expect(nodes[2][0]).toEqual({
+      objectType: 'node',
+      id: 2n,
+      labels: ['Person'],
+      properties: { id: 2n, name: 'name2' },
+    });
+    expect(await connection.ExecuteAndFetchAll('RETURN $x;', { x: 1n }))
+      .toEqual([[42n], ['text']]);
+
+    await expect(connection.ExecuteAndFetchAll('FAIL;')).rejects.toThrow();
+    // The connection is usable after the failure.
+    await connection.Begin();
+    expect(await connection.ExecuteAndFetchAll('UNKNOWN;')).toEqual([]);
+    await connection.Commit();
+    expect(server.stats.connections).toEqual(1);
+  });
+});
+
+test('Bolt server injects latency', async () => {
+  await util.checkAgainstBoltServer({
+    defaultResult: { shape: 'scalar', rows: 10 },
+    latency: (message) => message === 'RUN' ? 50 : 0,
+  }, async (port) => {
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+    });
+    const start = Date.now();
+    expect((await connection.ExecuteAndFetchAll('RETURN 1;')).length)
+      .toEqual(10);
+    expect(Date.now() - start).toBeGreaterThanOrEqual(45);
+  });
+});
+
+test('Connection stats count queries, rows and phases', async () => {
+  await util.checkAgainstBoltServer({
+    defaultResult: { shape: 'wide', rows: 5 },
+    results: { 'FAIL;': { error: { message: 'Scripted failure.' } } },
+  }, async (port) => {
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+    });
+    connection.ResetStats();
+    await connection.ExecuteAndFetchAll('RETURN 1;', { x: 1n });
+    await connection.ExecuteAndFetchAll('RETURN 2;');
+    await expect(connection.ExecuteAndFetchAll('FAIL;')).rejects.toThrow();
+
+    const stats = connection.Stats();
+    expect(stats.queries).toEqual(3);
+    expect(stats.commands).toEqual(3);
+    expect(stats.errors).toEqual(1);
+    expect(stats.rows).toEqual(10);
+    expect(stats.bytes).toBeGreaterThan(0);
+    expect(stats.network.count).toEqual(3);
+    expect(stats.conversion.count).toEqual(2);
+    expect(stats.encoding.count).toEqual(3);
+    for (const phase of ['queueWait', 'threadpoolWait', 'network']) {
+      const histogram = stats[phase];
+      expect(histogram.min).toBeLessThanOrEqual(histogram.p50);
+      expect(histogram.p50).toBeLessThanOrEqual(histogram.p99);
+      expect(histogram.p99).toBeLessThanOrEqual(histogram.max);
+    }
+
+    connection.ResetStats();
+    const reset = connection.Stats();
+    expect(reset.queries).toEqual(0);
+    expect(reset.network).toEqual({ count: 0, min: 0, mean: 0, p50: 0,
+      p90: 0, p99: 0, p999: 0, max: 0 });
+  });
+});
+
+test('Connection executes calls on its own I/O thread', async () => {
+  await util.checkAgainstBoltServer({
+    handler: (query) => ({ fields: ['q'], records: [[query]] }),
+    latency: 5,
+  }, async (port) => {
+    await expect(memgraph.Connect({ port: port, io_thread: 'yes' }))
+      .rejects.toThrow();
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+      io_thread: true,
+    });
+    const queries = [...Array(20).keys()].map((index) => `RETURN ${index};`);
+    const results = await Promise.all(queries.map((query) =>
+      connection.ExecuteAndFetchAll(query)));
+    expect(results).toEqual(queries.map((query) => [[query]]));
+
+    await connection.Begin();
+    await connection.ExecuteAndDiscardAll('CREATE ();');
+    await connection.Rollback();
+
+    const stats = connection.Stats();
+    expect(stats.queries).toEqual(21);
+    expect(stats.threadpoolWait.count).toEqual(0);
+    expect(stats.queueWait.count).toEqual(23);
+  });
+});
+
+test('Connection converts large results in time slices', async () => {
+  await util.checkAgainstBoltServer({
+    defaultResult: { shape: 'wide', rows: 50000 },
+  }, async (port) => {
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+    });
+    await expect(connection.ExecuteAndFetchAll('RETURN 1;', {},
+      { timeSlice: -1 })).rejects.toThrow();
+    const expected = await connection.ExecuteAndFetchAll('RETURN 1;');
+
+    let turns = 0;
+    const ticker = setInterval(() => ++turns, 0);
+    connection.ResetStats();
+    const sliced = await connection.ExecuteAndFetchAll('RETURN 1;', {},
+      { timeSlice: 200 });
+    clearInterval(ticker);
+    expect(sliced).toEqual(expected);
+    // The event loop kept running while the result was converted.
+    expect(turns).toBeGreaterThan(0);
+    expect(connection.Stats().conversion.count).toBeGreaterThan(1);
+
+    await connection.Execute('RETURN 1;');
+    expect(await connection.FetchAll({ timeSlice: 200 })).toEqual(expected);
+  });
+});
+
+test('Time sliced conversion keeps the interned keys valid', async () => {
+  await util.checkAgainstBoltServer({
+    defaultResult: { shape: 'node', rows: 20000 },
+  }, async (port) => {
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+    });
+    // Labels and property keys are interned once per slice while the
+    // converted rows are freed.
+    const nodes = await connection.ExecuteAndFetchAll('MATCH (n) RETURN n;',
+      {}, { timeSlice: 200, integers: 'number' });
+    expect(nodes.length).toEqual(20000);
+    nodes.forEach(([node], index) => expect(node).toEqual({
+      objectType: 'node',
+      id: index,
+      labels: ['Person'],
+      properties: { id: index, name: `name${index}` },
+    }));
+    expect(connection.Stats().conversion.count).toBeGreaterThan(1);
+  });
+});
+
+test('FetchOne is served from the read-ahead buffer', async () => {
+  await util.checkAgainstBoltServer({
+    defaultResult: { shape: 'scalar', rows: 1000 },
+  }, async (port) => {
+    await expect(memgraph.Connect({ port: port, read_ahead: -1 }))
+      .rejects.toThrow();
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+      read_ahead: 100,
+    });
+    await connection.Execute('UNWIND range(0, 999) AS n RETURN n;');
+    connection.ResetStats();
+    for (let index = 0; index < 500; ++index) {
+      expect(await connection.FetchOne()).toEqual([BigInt(index)]);
+    }
+    // One hop per read-ahead refill instead of one per record.
+    expect(connection.Stats().commands).toBeLessThan(20);
+    // The other fetch calls take the buffered records first.
+    const batch = await connection.client.FetchBatch(10);
+    expect(batch[0]).toEqual([500n]);
+    const rest = await connection.FetchAll();
+    expect(rest.length).toEqual(490);
+    expect(rest[0]).toEqual([510n]);
+    expect(rest[489]).toEqual([999n]);
+
+    await connection.Execute('UNWIND range(0, 999) AS n RETURN n;');
+    expect(await connection.FetchOne()).toEqual([0n]);
+    await connection.DiscardAll();
+    expect((await connection.ExecuteAndFetchAll('RETURN 1;')).length)
+      .toEqual(1000);
+  });
+});
+
+test('Stream fetches records as the consumer reads them', async () => {
+  await util.checkAgainstBoltServer({
+    results: {
+      'FAIL;': { error: { message: 'Scripted failure.' } },
+    },
+    defaultResult: { shape: 'scalar', rows: 1000 },
+  }, async (port) => {
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+    });
+    expect(() => connection.Stream('RETURN 1;', {}, { highWaterMark: 0 }))
+      .toThrow('The high water mark has to be a positive integer.');
+    connection.ResetStats();
+    const stream = connection.Stream('RETURN 1;', {}, { highWaterMark: 100 });
+    const records = [];
+    for await (const record of stream) {
+      records.push(record);
+    }
+    expect(records.length).toEqual(1000);
+    expect(records[999]).toEqual([999n]);
+    // Execute and one fetch per high-water mark of records.
+    expect(connection.Stats().commands).toBeGreaterThan(10);
+
+    await expect(new Promise((resolve, reject) => {
+      connection.Stream('FAIL;').on('error', reject).on('end', resolve)
+        .resume();
+    })).rejects.toThrow('Scripted failure.');
+    const early = connection.Stream('RETURN 1;', {}, { highWaterMark: 10 });
+    for await (const record of early) {
+      expect(record).toEqual([0n]);
+      break;
+    }
+    expect((await connection.ExecuteAndFetchAll('RETURN 1;')).length)
+      .toEqual(1000);
+  });
+});
+
+test('ExecuteMany runs all queries in one command', async () => {
+  await util.checkAgainstBoltServer({
+    handler: (query, params) => query === 'FAIL;' ?
+      { error: { message: 'Scripted failure.' } } :
+      { fields: ['id'], records: [[params.id]] },
+  }, async (port, server) => {
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+    });
+    await expect(connection.ExecuteMany([{ query: 1 }])).rejects.toThrow(
+      'ExecuteMany requires an array of { query, params } objects.');
+    const statements = [1, 2, 3].map((id) => ({
+      query: 'MATCH (n {id: $id}) RETURN n.id;',
+      params: { id: BigInt(id) },
+    }));
+    connection.ResetStats();
+    const results = await connection.ExecuteMany(
+      [...statements, { query: 'FAIL;' }, statements[0]],
+      { integers: 'number' });
+    expect(results.slice(0, 3)).toEqual([1, 2, 3].map((id) =>
+      ({ records: [[id]] })));
+    expect(results[3].error.message).toMatch('Scripted failure.');
+    expect(results[4]).toEqual({ records: [[1]] });
+    const stats = connection.Stats();
+    expect(stats.commands).toEqual(1);
+    expect(stats.queries).toEqual(5);
+
+    const transaction = await connection.ExecuteMany(
+      [statements[0], { query: 'FAIL;' }, statements[1]],
+      { transactional: true });
+    expect(transaction[0]).toEqual({ records: [[1n]] });
+    expect(transaction[1].error.message).toMatch('Scripted failure.');
+    expect(transaction[2].error.message).toEqual(
+      'Not executed, the transaction was rolled back.');
+    expect(server.stats.messages.COMMIT).toBeUndefined();
+    expect(await connection.ExecuteMany(statements, { transactional: true }))
+      .toEqual([1n, 2n, 3n].map((id) => ({ records: [[id]] })));
+    expect(server.stats.messages.COMMIT).toEqual(1);
+  });
+});
+
+test('Transaction retries conflicting transactions', async () => {
+  let conflicts = 0;
+  await util.checkAgainstBoltServer({
+    handler: (query) => query === 'CREATE (:Node);' && conflicts-- > 0 ?
+      { error: { message: 'Cannot resolve conflicting transactions.' } } :
+      { shape: 'scalar', rows: 1 },
+  }, async (port, server) => {
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+    });
+    await expect(connection.Transaction('CREATE (:Node);')).rejects.toThrow(
+      'Transaction requires a function or an array of statements.');
+    await expect(connection.Transaction([], { retries: NaN })).rejects
+      .toThrow('The retries have to be a non-negative integer.');
+    await expect(connection.Transaction([], { retryDelay: -1 })).rejects
+      .toThrow('The retry delay has to be a non-negative number.');
+
+    conflicts = 1;
+    let attempts = 0;
+    const result = await connection.Transaction(async (tx) => {
+      ++attempts;
+      await tx.ExecuteAndDiscardAll('CREATE (:Node);');
+      return tx.ExecuteAndFetchAll('RETURN 1;');
+    }, { retryDelay: 1 });
+    expect(result).toEqual([[0n]]);
+    expect(attempts).toEqual(2);
+    expect(server.stats.messages.COMMIT).toEqual(1);
+
+    conflicts = 1;
+    connection.ResetStats();
+    expect(await connection.Transaction([{ query: 'CREATE (:Node);' }],
+      { retryDelay: 1 })).toEqual([[[0n]]]);
+    // BEGIN, the statements and COMMIT in a single command per attempt.
+    expect(connection.Stats().commands).toEqual(2);
+    expect(server.stats.messages.COMMIT).toEqual(2);
+
+    conflicts = 2;
+    await expect(connection.Transaction([{ query: 'CREATE (:Node);' }],
+      { retries: 1, retryDelay: 1 })).rejects.toThrow(
+      'Cannot resolve conflicting transactions.');
+  });
+});
+
+test('Transactional BulkWrite never leaves the transaction open', async () => {
+  await util.checkAgainstBoltServer({}, async (port, server) => {
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+    });
+    const query = 'UNWIND $batch AS row CREATE (:Node {id: row.id});';
+    const rows = [{ id: 1n }, { id: 2n }];
+    await expect(connection.BulkWrite(query, rows,
+      { transactional: true, batchSize: 0 })).rejects.toThrow(
+      'The batch size has to be a positive integer.');
+    expect(server.stats.messages.BEGIN).toBeUndefined();
+    await expect(connection.BulkWrite(query, rows, {
+      transactional: true,
+      batchSize: 1,
+      onProgress: () => {
+        throw new Error('Progress failed.');
+      },
+    })).rejects.toThrow('Progress failed.');
+    expect(server.stats.messages.ROLLBACK).toEqual(1);
+    await connection.BulkWrite(query, rows, { transactional: true });
+    expect(server.stats.messages.COMMIT).toEqual(1);
+  });
+});
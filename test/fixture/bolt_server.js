@@ -0,0 +1,362 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// A minimal Bolt (v1 and v4.x) server replaying scripted results. It's
+// meant for tests and benchmarks of the client overhead, there is no query
+// engine behind it: every query is looked up in the script.
+
+const net = require('net');
+const {
+  Dechunker,
+  Signature,
+  Structure,
+  decodeMessage,
+  encodeMessage,
+} = require('../../lib/packstream');
+
+const BOLT_MAGIC = 0x6060b017;
+
+const Message = {
+  HELLO: 0x01,
+  GOODBYE: 0x02,
+  ACK_FAILURE: 0x0e,
+  RESET: 0x0f,
+  RUN: 0x10,
+  BEGIN: 0x11,
+  COMMIT: 0x12,
+  ROLLBACK: 0x13,
+  DISCARD: 0x2f,
+  PULL: 0x3f,
+  SUCCESS: 0x70,
+  RECORD: 0x71,
+  IGNORED: 0x7e,
+  FAILURE: 0x7f,
+};
+
+const MESSAGE_NAMES = Object.fromEntries(
+  Object.entries(Message).map(([name, signature]) => [signature, name]));
+
+// v1 clients control transactions with queries.
+const TRANSACTION_QUERIES = ['BEGIN', 'COMMIT', 'ROLLBACK'];
+
+function node(id, labels = [], properties = {}) {
+  return new Structure(Signature.NODE, [BigInt(id), labels, properties]);
+}
+
+function relationship(id, startId, endId, type, properties = {}) {
+  return new Structure(Signature.RELATIONSHIP, [BigInt(id), BigInt(startId),
+    BigInt(endId), type, properties]);
+}
+
+// A path n0-[r0]->n1-[r1]->...-[rN-1]->nN.
+function path(length) {
+  const nodes = [];
+  const relationships = [];
+  const sequence = [];
+  for (let index = 0; index <= length; ++index) {
+    nodes.push(node(index, ['Node'], { index: BigInt(index) }));
+  }
+  for (let index = 0; index < length; ++index) {
+    relationships.push(new Structure(Signature.UNBOUND_RELATIONSHIP,
+      [BigInt(index), 'NEXT', {}]));
+    sequence.push(BigInt(index + 1), BigInt(index + 1));
+  }
+  return new Structure(Signature.PATH, [nodes, relationships, sequence]);
+}
+
+const SHAPES = {
+  scalar: {
+    fields: ['n'],
+    record: (index) => [BigInt(index)],
+  },
+  wide: {
+    fields: ['id', 'name', 'score', 'active', 'tags'],
+    record: (index) => [BigInt(index), `name${index}`, index * 0.5,
+      index % 2 === 0, ['a', 'b', 'c']],
+  },
+  map: {
+    fields: ['row'],
+    record: (index) => [{ id: BigInt(index), name: `name${index}`,
+      nested: { values: [BigInt(index), index * 0.5] } }],
+  },
+  node: {
+    fields: ['n'],
+    record: (index) => [node(index, ['Person'],
+      { id: BigInt(index), name: `name${index}` })],
+  },
+  relationship: {
+    fields: ['r'],
+    record: (index) => [relationship(index, index, index + 1, 'KNOWS',
+      { since: BigInt(index) })],
+  },
+  path: {
+    fields: ['p'],
+    record: () => [path(10)],
+  },
+};
+
+/**
+  * Create a scripted result. `spec` is one of:
+  * - `{ fields, records }` - the given records;
+  * - `{ shape, rows }` - `rows` generated records of the shape (scalar,
+  *   wide, map, node, relationship or path);
+  * - `{ error: { code, message } }` - the query fails.
+  * @return {Object} `{ fields, count, record(index) }` or `{ error }`.
+  */
+function createResult(spec = {}) {
+  if (spec.error) {
+    return { error: spec.error };
+  }
+  if (spec.records) {
+    return {
+      fields: spec.fields || [],
+      count: spec.records.length,
+      record: (index) => spec.records[index],
+    };
+  }
+  const shape = SHAPES[spec.shape || 'scalar'];
+  if (!shape) {
+    throw new Error(`Unknown result shape ${spec.shape}.`);
+  }
+  return {
+    fields: shape.fields,
+    count: spec.rows === undefined ? 1 : spec.rows,
+    record: shape.record,
+  };
+}
+
+const EMPTY_RESULT = createResult({ records: [] });
+
+class Session {
+  constructor(server, socket, id) {
+    this.server = server;
+    this.socket = socket;
+    this.id = id;
+    this.version = null;
+    this.handshake = Buffer.alloc(0);
+    this.dechunker = new Dechunker();
+    this.failed = false;
+    this.result = null;
+    this.offset = 0;
+    // Messages are handled one by one, also when latency is injected.
+    this.queue = Promise.resolve();
+    socket.setNoDelay(true);
+    socket.on('data', (data) => this.onData(data));
+    socket.on('error', () => socket.destroy());
+  }
+
+  onData(data) {
+    if (this.version === null) {
+      this.handshake = Buffer.concat([this.handshake, data]);
+      if (this.handshake.length < 20) {
+        return;
+      }
+      data = this.handshake.subarray(20);
+      this.version = this.negotiate(this.handshake);
+      if (this.version === null) {
+        this.socket.end(Buffer.alloc(4));
+        return;
+      }
+      this.socket.write(Buffer.from([0, 0, this.version.minor,
+        this.version.major]));
+    }
+    for (const message of this.dechunker.push(data)) {
+      const request = decodeMessage(message);
+      this.queue = this.queue
+        .then(() => this.handle(request))
+        .catch(() => this.socket.destroy());
+    }
+  }
+
+  negotiate(handshake) {
+    if (handshake.readUInt32BE(0) !== BOLT_MAGIC) {
+      return null;
+    }
+    for (let offset = 4; offset < 20; offset += 4) {
+      const major = handshake.readUInt8(offset + 3);
+      const minor = handshake.readUInt8(offset + 2);
+      if (major === 4 || (major === 1 && minor === 0)) {
+        return { major: major, minor: minor };
+      }
+    }
+    return null;
+  }
+
+  async handle(request) {
+    const name = MESSAGE_NAMES[request.signature] || 'UNKNOWN';
+    this.server.count(name);
+    const latency = this.server.latency(name);
+    if (latency > 0) {
+      await new Promise((resolve) => setTimeout(resolve, latency));
+    }
+    if (request.signature === Message.GOODBYE) {
+      this.socket.end();
+      return;
+    }
+    if (request.signature === Message.RESET ||
+        request.signature === Message.ACK_FAILURE) {
+      this.failed = false;
+      this.result = null;
+      this.respond([[Message.SUCCESS, {}]]);
+      return;
+    }
+    if (this.failed) {
+      this.respond([[Message.IGNORED, []]]);
+      return;
+    }
+    this.respond(this.process(request));
+  }
+
+  process(request) {
+    switch (request.signature) {
+      case Message.HELLO:
+        return [[Message.SUCCESS, {
+          server: 'Neo4j/v4.3.0 compatible graph database server - Memgraph',
+          connection_id: `bolt-${this.id}`,
+        }]];
+      case Message.RUN: {
+        const [query, params] = request.fields;
+        const result = TRANSACTION_QUERIES.includes(query.trim()) ?
+          EMPTY_RESULT : this.server.resolve(query, params || {});
+        if (result.error) {
+          return this.fail(result.error);
+        }
+        this.result = result;
+        this.offset = 0;
+        return [[Message.SUCCESS, { fields: result.fields, t_first: 0n }]];
+      }
+      case Message.PULL:
+      case Message.DISCARD: {
+        if (!this.result) {
+          return this.fail({ message: 'There is no result to pull.' });
+        }
+        const extra = request.fields[0] || {};
+        const remaining = this.result.count - this.offset;
+        const n = extra.n === undefined || extra.n < 0n ?
+          remaining : Math.min(Number(extra.n), remaining);
+        const responses = [];
+        if (request.signature === Message.PULL) {
+          for (let index = 0; index < n; ++index) {
+            responses.push([Message.RECORD,
+              this.result.record(this.offset + index)]);
+          }
+        }
+        this.offset += n;
+        const hasMore = this.offset < this.result.count;
+        if (!hasMore) {
+          this.result = null;
+        }
+        const summary = { has_more: hasMore };
+        if (!hasMore) {
+          summary.t_last = 0n;
+          summary.type = 'rw';
+        }
+        responses.push([Message.SUCCESS, summary]);
+        return responses;
+      }
+      case Message.BEGIN:
+      case Message.COMMIT:
+      case Message.ROLLBACK:
+        return [[Message.SUCCESS, {}]];
+      default:
+        return this.fail({ message: 'Unsupported message.' });
+    }
+  }
+
+  fail(error) {
+    this.failed = true;
+    this.result = null;
+    return [[Message.FAILURE, {
+      code: error.code || 'Memgraph.ClientError.MemgraphError.MemgraphError',
+      message: error.message || 'Scripted failure.',
+    }]];
+  }
+
+  respond(responses) {
+    // A RECORD carries one list field, the other messages one map field.
+    this.socket.write(Buffer.concat(responses.map(([signature, field]) =>
+      encodeMessage(signature, signature === Message.IGNORED ? [] :
+        [field]))));
+  }
+}
+
+/**
+  * Bolt stand-in server.
+  * @param {Object} options - `{ results, defaultResult, handler, latency }`.
+  * `results` maps the exact query text to a result spec (see createResult),
+  * `defaultResult` is used for unknown queries (an empty result by default)
+  * and `handler(query, params)` returns a spec and takes precedence over
+  * both. `latency` is the delay in ms before each message is handled, or a
+  * function of the message name (e.g. 'RUN', 'PULL') returning the delay.
+  */
+class BoltServer {
+  constructor(options = {}) {
+    this.results = new Map(Object.entries(options.results || {})
+      .map(([query, spec]) => [query, createResult(spec)]));
+    this.defaultResult = createResult(options.defaultResult ||
+      { records: [] });
+    this.handler = options.handler;
+    this.latencyOption = options.latency || 0;
+    this.sessions = new Set();
+    this.stats = { connections: 0, messages: {} };
+    this.server = net.createServer((socket) => {
+      const session = new Session(this, socket, ++this.stats.connections);
+      this.sessions.add(session);
+      socket.on('close', () => this.sessions.delete(session));
+    });
+  }
+
+  /**
+    * Start listening.
+    * @param {number} port - 0 picks a free port.
+    * @return {Promise<number>} The port.
+    */
+  listen(port = 0, host = '127.0.0.1') {
+    return new Promise((resolve, reject) => {
+      this.server.once('error', reject);
+      this.server.listen(port, host, () => resolve(this.server.address().port));
+    });
+  }
+
+  close() {
+    for (const session of this.sessions) {
+      session.socket.destroy();
+    }
+    return new Promise((resolve) => this.server.close(() => resolve()));
+  }
+
+  resolve(query, params) {
+    if (this.handler) {
+      return createResult(this.handler(query, params));
+    }
+    return this.results.get(query) || this.defaultResult;
+  }
+
+  latency(name) {
+    return typeof this.latencyOption === 'function' ?
+      this.latencyOption(name) : this.latencyOption;
+  }
+
+  count(name) {
+    this.stats.messages[name] = (this.stats.messages[name] || 0) + 1;
+  }
+}
+
+module.exports = {
+  BoltServer,
+  createResult,
+  node,
+  path,
+  relationship,
+};
@@ -0,0 +1,144 @@
+// Copyright (c) 2016-2021 Memgraph Ltd. [https://memgraph.com]
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+const getPort = require('get-port');
+
+const memgraph = require('..');
+const util = require('./util');
+
+test('Pool opens min connections and grows up to max', async () => {
+  const port = await getPort();
+  await util.checkAgainstMemgraph(async () => {
+    const pool = await memgraph.CreatePool({
+      host: '127.0.0.1',
+      port: port,
+      min: 2,
+      max: 3,
+    });
+    expect(pool.Status()).toEqual(
+      expect.objectContaining({ size: 2, idle: 2, leased: 0 }),
+    );
+
+    const results = await Promise.all(
+      [...Array(10).keys()].map((index) =>
+        pool.ExecuteAndFetchAll('RETURN $index;', { index: BigInt(index) }),
+      ),
+    );
+    results.forEach((result, index) => {
+      expect(util.firstRecord(result)).toEqual(BigInt(index));
+    });
+    const status = pool.Status();
+    expect(status.size).toBeLessThanOrEqual(3);
+    expect(status.leased).toEqual(0);
+    expect(status.waiting).toEqual(0);
+    pool.Close();
+  }, port);
+}, 10000);
+
+test('Pool serves waiters in order once a connection is released', async () => {
+  const port = await getPort();
+  await util.checkAgainstMemgraph(async () => {
+    const pool = await memgraph.CreatePool({
+      host: '127.0.0.1',
+      port: port,
+      min: 1,
+      max: 1,
+    });
+    const first = await pool.Acquire();
+    const order = [];
+    const second = pool.Acquire().then((connection) => {
+      order.push(2);
+      return connection;
+    });
+    const third = pool.Acquire().then((connection) => {
+      order.push(3);
+      return connection;
+    });
+    expect(pool.Status().waiting).toEqual(2);
+    pool.Release(first);
+    pool.Release(await second);
+    pool.Release(await third);
+    expect(order).toEqual([2, 3]);
+    expect(() => pool.Release(first)).toThrow();
+    pool.Close();
+    await expect(pool.Acquire()).rejects.toThrow();
+  }, port);
+}, 10000);
+
+test('Pool spreads bulk write batches over connections', async () => {
+  const port = await getPort();
+  await util.checkAgainstMemgraph(async () => {
+    const pool = await memgraph.CreatePool({
+      host: '127.0.0.1',
+      port: port,
+      min: 1,
+      max: 3,
+    });
+    const rows = [...Array(100).keys()].map((id) => ({ id: BigInt(id) }));
+    const report = await pool.BulkWrite(
+      'UNWIND $batch AS row CREATE (:PoolBulk {id: row.id});', rows,
+      { batchSize: 7, maxInFlight: 3 });
+    expect(report.writtenRows).toEqual(100);
+    expect(report.errors).toEqual([]);
+    expect(pool.Status().leased).toEqual(0);
+    const count = await pool.ExecuteAndFetchAll(
+      'MATCH (n:PoolBulk) RETURN count(n);');
+    expect(util.firstRecord(count)).toEqual(100n);
+    pool.Close();
+  }, port);
+}, 10000);
+
+test('Pool replaces a discarded connection for a waiter', async () => {
+  await util.checkAgainstBoltServer({}, async (port) => {
+    const pool = await memgraph.CreatePool({
+      host: '127.0.0.1',
+      port: port,
+      min: 0,
+      max: 1,
+    });
+    const first = await pool.Acquire();
+    const second = pool.Acquire();
+    expect(pool.Status().waiting).toEqual(1);
+    pool.Release(first, true);
+    const connection = await second;
+    expect(await connection.ExecuteAndFetchAll('RETURN 1;')).toEqual([]);
+    pool.Release(connection);
+    expect(pool.Status()).toEqual(
+      expect.objectContaining({ size: 1, idle: 1, waiting: 0 }),
+    );
+    pool.Close();
+  });
+});
+
+test('Pool bulk write caps the lanes at the pool size', async () => {
+  await util.checkAgainstBoltServer({}, async (port, server) => {
+    const pool = await memgraph.CreatePool({
+      host: '127.0.0.1',
+      port: port,
+      min: 1,
+      max: 2,
+    });
+    const rows = [...Array(10).keys()].map((id) => ({ id: BigInt(id) }));
+    const report = await pool.BulkWrite(
+      'UNWIND $batch AS row CREATE (:Node {id: row.id});', rows,
+      { batchSize: 1, maxInFlight: 4 });
+    expect(report.writtenBatches).toEqual(10);
+    expect(report.errors).toEqual([]);
+    expect(server.stats.connections).toBeLessThanOrEqual(2);
+    expect(pool.Status()).toEqual(
+      expect.objectContaining({ leased: 0, waiting: 0 }),
+    );
+    pool.Close();
+  });
+});
@@ -91,6 +91,13 @@ test('Queries basic graph', async () => {
     );
     expect(edgesNo).toEqual(3n);
     await expect(connection.Execute('QUERY')).rejects.toThrow();
+    await expect(connection.ExecuteAndFetchAll('QUERY')).rejects.toThrow();
+
+    await connection.ExecuteAndDiscardAll(query.DELETE_ALL);
+    const emptyNodesNo = util.firstRecord(
+      await connection.ExecuteAndFetchAll(query.COUNT_NODES),
+    );
+    expect(emptyNodesNo).toEqual(0n);
   }, port);
 }, 10000);
 
@@ -340,3 +347,350 @@ test('Queries query parameters not provided', async () => {
     ).rejects.toThrow();
   }, port);
 }, 10000);
+
+test('Queries lazy execution consumed by a cursor', async () => {
+  const port = await getPort();
+  await util.checkAgainstMemgraph(async () => {
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+    });
+    expect(connection).toBeDefined();
+
+    const cursor = await connection.ExecuteLazy(
+      'UNWIND range(1, 10) AS x RETURN x;',
+      {},
+      { batchSize: 3 },
+    );
+    const records = [];
+    for await (const record of cursor) {
+      records.push(record[0]);
+    }
+    expect(records.length).toEqual(10);
+    expect(records[0]).toEqual(1n);
+    expect(records[9]).toEqual(10n);
+
+    const earlyStop = await connection.ExecuteLazy(
+      'UNWIND range(1, 10) AS x RETURN x;',
+      {},
+      { batchSize: 4 },
+    );
+    for await (const record of earlyStop) {
+      expect(record[0]).toEqual(1n);
+      break;
+    }
+    const numbers = await connection.ExecuteLazy(
+      'UNWIND range(1, 3) AS x RETURN x;',
+      {},
+      { batchSize: 2, integers: 'number' },
+    );
+    expect(await numbers.FetchBatch()).toEqual([[1], [2]]);
+    await numbers.Close();
+    const value = util.firstRecord(
+      await connection.ExecuteAndFetchAll('RETURN 1;'),
+    );
+    expect(value).toEqual(1n);
+  }, port);
+}, 10000);
+
+test('Queries issued without awaiting are executed in order', async () => {
+  const port = await getPort();
+  await util.checkAgainstMemgraph(async () => {
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+    });
+    expect(connection).toBeDefined();
+
+    const [, first, second, count] = await Promise.all([
+      connection.Begin(),
+      connection.ExecuteAndFetchAll('CREATE (n {id: 1}) RETURN n.id;'),
+      connection.ExecuteAndFetchAll('CREATE (n {id: 2}) RETURN n.id;'),
+      connection.ExecuteAndFetchAll(query.COUNT_NODES),
+      connection.Commit(),
+    ]);
+    expect(util.firstRecord(first)).toEqual(1n);
+    expect(util.firstRecord(second)).toEqual(2n);
+    expect(util.firstRecord(count)).toEqual(2n);
+
+    const results = await Promise.all([
+      connection.ExecuteAndFetchAll('QUERY'),
+      connection.ExecuteAndFetchAll('RETURN 3;'),
+    ].map((promise) => promise.catch((error) => error)));
+    expect(results[0]).toBeInstanceOf(Error);
+    expect(util.firstRecord(results[1])).toEqual(3n);
+  }, port);
+}, 10000);
+
+test('Queries fetch numeric columns as typed arrays', async () => {
+  const port = await getPort();
+  await util.checkAgainstMemgraph(async () => {
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+    });
+    expect(connection).toBeDefined();
+
+    const result = await connection.ExecuteAndFetchColumns(`
+      UNWIND range(0, 9) AS x
+      RETURN x, x * 0.5, CASE WHEN x % 2 = 0 THEN x END, toString(x);`);
+    expect(result.rowCount).toEqual(10);
+    const [ints, floats, nullable, strings] = result.columns;
+    expect(ints.type).toEqual('integer');
+    expect(ints.values).toBeInstanceOf(BigInt64Array);
+    expect(ints.values[9]).toEqual(9n);
+    expect(ints.validity).toEqual(null);
+    expect(floats.type).toEqual('float');
+    expect(floats.values).toBeInstanceOf(Float64Array);
+    expect(floats.values[3]).toEqual(1.5);
+    expect(nullable.type).toEqual('integer');
+    expect(Array.from(nullable.validity)).toEqual([0b01010101, 0b01]);
+    expect(strings.type).toEqual('mixed');
+    expect(strings.values[2]).toEqual('2');
+
+    const empty = await connection.ExecuteAndFetchColumns(`
+      UNWIND [] AS x RETURN x, x * 0.5;`);
+    expect(empty).toEqual({
+      rowCount: 0,
+      columns: [
+        { type: 'mixed', values: [], validity: null },
+        { type: 'mixed', values: [], validity: null },
+      ],
+    });
+  }, port);
+}, 10000);
+
+test('Queries fetch lazy graph objects', async () => {
+  const port = await getPort();
+  await util.checkAgainstMemgraph(async () => {
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+    }, { lazyGraph: true });
+    expect(connection).toBeDefined();
+
+    await connection.ExecuteAndFetchAll(query.DELETE_ALL);
+    await connection.ExecuteAndFetchAll(query.CREATE_PATH);
+
+    const data = await connection.ExecuteAndFetchAll(query.MATCH_PATHS);
+    const longestPath = data[2][0];
+    expect(longestPath).toBeInstanceOf(memgraph.Path);
+    const node = longestPath.nodes[1];
+    expect(node).toBeInstanceOf(memgraph.Node);
+    expect(node.getProperty('id')).toEqual(2n);
+    expect(node.getProperty('missing')).toEqual(undefined);
+    expect(node.labels).toEqual(['Label']);
+    expect(node.properties).toBe(node.properties);
+    const relationship = longestPath.relationships[2];
+    expect(relationship).toBeInstanceOf(memgraph.Relationship);
+    expect(relationship.startNodeId).toEqual(2n);
+    expect(relationship.endNodeId).toEqual(3n);
+    expect(relationship.edgeType).toEqual('Type');
+
+    const eager = await connection.ExecuteAndFetchAll(query.MATCH_PATHS, {},
+      { lazyGraph: false });
+    expect(longestPath.toJSON()).toEqual(eager[2][0]);
+    expect(() => new memgraph.Node()).toThrow();
+  }, port);
+}, 10000);
+
+test('Queries fetch integers as numbers', async () => {
+  const port = await getPort();
+  await util.checkAgainstMemgraph(async () => {
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+    }, { integers: 'auto' });
+    expect(connection).toBeDefined();
+
+    const [[small, big, node]] = await connection.ExecuteAndFetchAll(
+      'CREATE (n) RETURN 42, 9007199254740993, n;');
+    expect(small).toEqual(42);
+    expect(big).toEqual(9007199254740993n);
+    expect(typeof node.id).toEqual('number');
+
+    const [[duration]] = await connection.ExecuteAndFetchAll(
+      'RETURN duration({days: 1, seconds: 2});', {}, { integers: 'number' });
+    expect(duration.days).toEqual(1);
+    expect(duration.seconds).toEqual(2);
+
+    const [[bigint]] = await connection.ExecuteAndFetchAll(
+      'RETURN 42;', {}, { integers: 'bigint' });
+    expect(bigint).toEqual(42n);
+    expect(() => connection.SetOptions({ integers: 'float' })).toThrow();
+  }, port);
+}, 10000);
+
+test('Queries fetch a result snapshot', async () => {
+  const port = await getPort();
+  await util.checkAgainstMemgraph(async () => {
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+    });
+    expect(connection).toBeDefined();
+
+    await connection.ExecuteAndFetchAll(query.DELETE_ALL);
+    await connection.ExecuteAndFetchAll(query.CREATE_PATH);
+
+    const matchAll = `
+      MATCH p=()-[]->()
+      RETURN p, 1, 2.5, 'text', [1, null, true], {key: 'value'},
+        date('2021-01-01'), duration({days: 1});`;
+    const expected = await connection.ExecuteAndFetchAll(matchAll);
+    const snapshot = await connection.ExecuteAndFetchSnapshot(matchAll);
+    expect(snapshot).toBeInstanceOf(memgraph.ResultSnapshot);
+    expect(snapshot.rowCount).toEqual(expected.length);
+    expect(snapshot.cellCount(0)).toEqual(8);
+    expect(snapshot.cell(1, 3)).toEqual('text');
+    expect(snapshot.toArray()).toEqual(expected);
+    expect([...snapshot]).toEqual(expected);
+
+    const numbers = await connection.ExecuteAndFetchSnapshot(
+      'RETURN 42, -9007199254740993;', {}, { integers: 'auto' });
+    expect(numbers.row(0)).toEqual([42, -9007199254740993n]);
+
+    connection.SetOptions({ integers: 'number' });
+    const defaults = await connection.ExecuteAndFetchSnapshot('RETURN 42;');
+    expect(defaults.row(0)).toEqual([42]);
+  }, port);
+}, 10000);
+
+test('Queries pass typed arrays as list parameters', async () => {
+  const port = await getPort();
+  await util.checkAgainstMemgraph(async () => {
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+    });
+    expect(connection).toBeDefined();
+
+    const [[floats, halves, ints, bigints, bytes]] =
+      await connection.ExecuteAndFetchAll(
+        'RETURN $floats, $halves, $ints, $bigints, $bytes;', {
+          floats: new Float64Array([0.25, 1.5]),
+          halves: new Float32Array([0.5]),
+          ints: new Int32Array([-1, 2]),
+          bigints: new BigInt64Array([3n]),
+          bytes: Buffer.from([1, 255]),
+        });
+    expect(floats).toEqual([0.25, 1.5]);
+    expect(halves).toEqual([0.5]);
+    expect(ints).toEqual([-1n, 2n]);
+    expect(bigints).toEqual([3n]);
+    expect(bytes).toEqual([1n, 255n]);
+  }, port);
+}, 10000);
+
+test('Queries fetch numeric lists as typed arrays', async () => {
+  const port = await getPort();
+  await util.checkAgainstMemgraph(async () => {
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+    }, { typedLists: true });
+    expect(connection).toBeDefined();
+
+    const [[floats, ints, mixed, empty, node]] =
+      await connection.ExecuteAndFetchAll(`
+        CREATE (n {embedding: [0.5, 1.5]})
+        RETURN [0.25, 2.0], [1, 2, 3], [1, 2.0], [], n;`);
+    expect(floats).toBeInstanceOf(Float64Array);
+    expect(Array.from(floats)).toEqual([0.25, 2.0]);
+    expect(ints).toBeInstanceOf(BigInt64Array);
+    expect(Array.from(ints)).toEqual([1n, 2n, 3n]);
+    expect(mixed).toEqual([1n, 2.0]);
+    expect(empty).toEqual([]);
+    expect(node.properties.embedding).toBeInstanceOf(Float64Array);
+  }, port);
+}, 10000);
+
+test('Queries write rows in pipelined batches', async () => {
+  const port = await getPort();
+  await util.checkAgainstMemgraph(async () => {
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+    });
+    expect(connection).toBeDefined();
+
+    await connection.ExecuteAndFetchAll(query.DELETE_ALL);
+    const rows = [...Array(25).keys()].map((id) => ({ id: BigInt(id) }));
+    const progress = [];
+    const report = await connection.BulkWrite(
+      'UNWIND $batch AS row CREATE (:Bulk {id: row.id, tag: $tag});', rows, {
+        batchSize: 10,
+        maxInFlight: 2,
+        params: { tag: 'first' },
+        onProgress: (status) => progress.push(status.writtenRows),
+      });
+    expect(report).toEqual(expect.objectContaining({
+      batches: 3, writtenRows: 25, errors: [],
+    }));
+    // The batches of one connection are executed in the issue order.
+    expect(progress).toEqual([10, 20, 25]);
+
+    await expect(connection.BulkWrite(
+      'UNWIND $batch AS row CREATE (:Bulk {id: 1 / row.zero});',
+      [{ zero: 1n }, { zero: 0n }],
+      { batchSize: 1, transactional: true })).rejects.toThrow();
+    const count = await connection.ExecuteAndFetchAll(
+      'MATCH (n:Bulk) RETURN count(n);');
+    expect(util.firstRecord(count)).toEqual(25n);
+  }, port);
+}, 10000);
+
+test('Queries execute a prepared statement', async () => {
+  const port = await getPort();
+  await util.checkAgainstMemgraph(async () => {
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+    });
+    expect(connection).toBeDefined();
+
+    const statement = connection.Prepare('RETURN $a AS a, $b AS b;');
+    expect(statement.query).toEqual('RETURN $a AS a, $b AS b;');
+    expect(util.firstRecord(
+      await statement.ExecuteAndFetchAll({ a: 1n, b: 'x' }))).toEqual(1n);
+    const record = await statement.ExecuteAndFetchAll({ a: 2n, b: 'y' });
+    expect(record).toEqual([[2n, 'y']]);
+    // The changed key set rebuilds the cached keys.
+    await expect(statement.ExecuteAndFetchAll({ a: 3n, c: 'z' }))
+      .rejects.toThrow();
+    expect(await statement.ExecuteAndFetchAll({ b: 'w', a: 4n }, {
+      integers: 'number',
+    })).toEqual([[4, 'w']]);
+    await statement.ExecuteAndDiscardAll({ a: 5n, b: 'v' });
+    // Only the cached keys are looked up, the extra ones aren't sent.
+    expect(await statement.ExecuteAndFetchAll({ a: 6n, b: 'u', c: 'x' }))
+      .toEqual([[6n, 'u']]);
+    expect(() => connection.Prepare(1)).toThrow();
+  }, port);
+}, 10000);
+
+test('Queries pass large and nested query parameters', async () => {
+  const port = await getPort();
+  await util.checkAgainstMemgraph(async () => {
+    const connection = await memgraph.Connect({
+      host: '127.0.0.1',
+      port: port,
+    });
+    expect(connection).toBeDefined();
+
+    const list = [...Array(50000).keys()].map((index) => ({
+      id: BigInt(index),
+      name: `name\u0000${index}`,
+    }));
+    const [[size, first, last]] = await connection.ExecuteAndFetchAll(
+      'RETURN size($list), $list[0], $list[-1];', { list: list });
+    expect(size).toEqual(50000n);
+    expect(first).toEqual({ id: 0n, name: 'name\u00000' });
+    expect(last).toEqual({ id: 49999n, name: 'name\u000049999' });
+
+    // Invalid values are still rejected before the query is queued.
+    await expect(connection.ExecuteAndFetchAll('RETURN $a;', {
+      a: [1n, { b: 2n ** 64n }],
+    })).rejects.toThrow();
+  }, port);
+}, 10000);
@@ -14,6 +14,7 @@
 
 const Docker = require('dockerode');
 const assert = require('assert');
+const { BoltServer } = require('./fixture/bolt_server');
 
 const docker = new Docker({ socketPath: '/var/run/docker.sock' });
 
@@ -60,6 +61,18 @@ async function checkAgainstMemgraph(check, port = 7687, sslEnabled = false) {
   }
 }
 
+// Runs the check against the in-process Bolt stand-in server, which replays
+// the scripted results, see fixture/bolt_server.js.
+async function checkAgainstBoltServer(options, check) {
+  const server = new BoltServer(options);
+  const port = await server.listen();
+  try {
+    await check(port, server);
+  } finally {
+    await server.close();
+  }
+}
+
 function firstRecord(result) {
   assert(!!result && typeof result === 'object', 'Result has to be Object');
   const data = result[0];
@@ -69,6 +82,7 @@ function firstRecord(result) {
 }
 
 module.exports = {
+  checkAgainstBoltServer,
   checkAgainstMemgraph,
   firstRecord,
 };
@@ -14,7 +14,8 @@
       'cflags': [ '-fexceptions' ],
       'cflags_cc': [ '-fexceptions' ],
       'defines': [ 'NAPI_CPP_EXCEPTIONS=1' ],
-      'sources': [ 'src/addon.cpp', 'src/client.cpp', 'src/glue.cpp' ],
+      'sources': [ 'src/addon.cpp', 'src/arena.cpp', 'src/client.cpp', 'src/glue.cpp', 'src/graph.cpp', 'src/io_thread.cpp', 'src/params.cpp', 'src/pool.cpp',
+                   'src/read_ahead.cpp', 'src/snapshot.cpp', 'src/statement.cpp', 'src/stats.cpp' ],
       'include_dirs': [ "<!@(node -p \"require('node-addon-api').include\")", "build/mgclient/include" ],
       'conditions': [
         ['OS=="win"', {